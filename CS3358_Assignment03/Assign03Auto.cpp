@@ -719,6 +719,43 @@ int test7()
         )
         return 0;
 
+    cout << "Testing that a sequence constructed with an initial capacity\n";
+    cout << "of 0 gets DEFAULT_CAPACITY instead: attaching that many items\n";
+    cout << "should NOT need a resize, and attach and insert should then\n";
+    cout << "work correctly past it." << endl;
+    sequence zeroa(0), zeroi(0);
+    char bytes[sizeof(sequence)];
+    char newbytes[sizeof(sequence)];
+    size_t mismatches = 0;
+    zeroa.attach(1);
+    memcpy(bytes, (char *) &zeroa, sizeof(sequence));
+
+    // Without a resize, at most 2 bytes of the object will change (the
+    // least significant bytes of used and current_index).
+    for (i = 2; i <= zeroa.DEFAULT_CAPACITY; i++)
+        zeroa.attach(i);
+    memcpy(newbytes, (char *) &zeroa, sizeof(sequence));
+    for (i = 0; i < sizeof(sequence); i++)
+        if (bytes[i] != newbytes[i])
+            mismatches++;
+    if (mismatches > 2)
+    {
+        cout << "    sequence was resized when it should not be." << endl;
+        return 0;
+    }
+    for (i = zeroa.DEFAULT_CAPACITY + 1; i <= 2*zeroa.DEFAULT_CAPACITY; i++)
+        zeroa.attach(i);
+    if (!correct
+        (zeroa, 2*zeroa.DEFAULT_CAPACITY, 2*zeroa.DEFAULT_CAPACITY-1, items)
+        )
+        return 0;
+    for (i = 2*zeroi.DEFAULT_CAPACITY; i >= 1; i--)
+        zeroi.insert(i);
+    if (!correct
+        (zeroi, 2*zeroi.DEFAULT_CAPACITY, 0, items)
+        )
+        return 0;
+
     // All tests passed
     cout << "All tests of this seventh function have been passed." << endl;
     return POINTS[7];
@@ -0,0 +1,381 @@
+// FILE: ChunkedSequence.cpp
+// CLASS IMPLEMENTED: chunked_sequence (see ChunkedSequence.h for
+//                    documentation)
+// INVARIANT for the chunked_sequence ADT:
+//   1. The number of items in the sequence is in the member variable
+//      used.
+//   2. The chunks in use are pointed to by chunks[0] through
+//      chunks[chunk_count - 1]; the chunk table (a dynamic array
+//      pointed to by the member variable chunks) has room for
+//      table_capacity (at least 1) pointers, and we don't care what's
+//      in the rest of it.
+//   3. The items of the sequence are stored, in order, in items[0]
+//      through items[count - 1] of chunks[0], then of chunks[1], and
+//      so on. No chunk in use is empty (so an empty sequence has no
+//      chunks).
+//   4. The index of the current item is in the member variable
+//      current_index, and the current item is
+//      chunks[current_chunk]->items[current_offset]. If there is no
+//      valid current item, current_index is the same number as used
+//      (see Sequence.cpp for why), current_chunk is the same number as
+//      chunk_count and current_offset is 0.
+//   Two neighboring chunks are merged when they hold at most
+//   CHUNK_CAPACITY / 2 items between them, which keeps the chunks (on
+//   average) at least a quarter full.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   static chunk** copy_table(const chunked_sequence& source,
+//                             size_type table_capacity)
+//    Pre:  table_capacity >= source.chunk_count and table_capacity > 0
+//    Post: A new chunk table with room for table_capacity pointers,
+//      pointing to new copies of the chunks of source, is returned.
+//   void resize_table(size_type new_table_capacity)
+//    Pre:  new_table_capacity >= chunk_count and new_table_capacity > 0
+//    Post: The chunk table has room for new_table_capacity pointers;
+//      the chunks are unchanged.
+//   void insert_chunk(size_type at)
+//    Pre:  at <= chunk_count
+//    Post: A new, empty chunk is chunks[at] (the chunks from at on
+//      have moved up one place, doubling the table if it was full).
+//   void erase_chunk(size_type at)
+//    Pre:  at < chunk_count
+//    Post: chunks[at] has been freed and the chunks after it have moved
+//      down one place.
+//   void insert_at(size_type at, size_type offset,
+//                  const value_type& entry)
+//    Pre:  at < chunk_count and offset <= chunks[at]->count, or else
+//      at == offset == chunk_count == 0
+//    Post: A copy of entry has been inserted so that it comes just
+//      before item offset of chunks[at] (just after its last item if
+//      offset == chunks[at]->count); a full chunk has been split in
+//      two first (or a new chunk started, for an entry at either end
+//      of it). current_chunk and current_offset give the place of the
+//      new item; current_index is unchanged.
+
+#include <cassert>
+#include "ChunkedSequence.h"
+using namespace std;
+
+namespace CS3358_FA2017
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   chunked_sequence::chunked_sequence(size_type initial_capacity)
+      : chunk_count(0), used(0), current_index(0), current_chunk(0),
+        current_offset(0)
+   {
+       table_capacity = (initial_capacity + CHUNK_CAPACITY - 1)
+                        / CHUNK_CAPACITY;
+       if (table_capacity < 1)
+       {
+           table_capacity = 1;
+       }
+       chunks = new chunk*[table_capacity];
+   }
+
+   chunked_sequence::chunked_sequence(const chunked_sequence& source)
+      : chunk_count(source.chunk_count), used(source.used),
+        current_index(source.current_index),
+        current_chunk(source.current_chunk),
+        current_offset(source.current_offset)
+   {
+       table_capacity = (chunk_count > 0) ? chunk_count : 1;
+       chunks = copy_table(source, table_capacity);
+   }
+
+   chunked_sequence::~chunked_sequence()
+   {
+       for (size_type i = 0; i < chunk_count; i++)
+       {
+           delete chunks[i];
+       }
+       delete [] chunks;
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void chunked_sequence::resize(size_type new_capacity)
+   {
+       size_type new_table_capacity = (new_capacity + CHUNK_CAPACITY - 1)
+                                      / CHUNK_CAPACITY;
+       if (new_table_capacity < chunk_count)
+       {
+           new_table_capacity = chunk_count;
+       }
+       if (new_table_capacity < 1)
+       {
+           new_table_capacity = 1;
+       }
+       if (new_table_capacity != table_capacity)
+       {
+           resize_table(new_table_capacity);
+       }
+   }
+
+   void chunked_sequence::start()
+   {
+       current_index = 0;
+       current_chunk = 0;
+       current_offset = 0;
+   }
+
+   void chunked_sequence::advance()
+   {
+       if (is_item())
+       {
+           current_index = current_index + 1;
+           current_offset = current_offset + 1;
+           if (current_offset == chunks[current_chunk]->count)
+           {
+               current_chunk = current_chunk + 1;
+               current_offset = 0;
+           }
+       }
+   }
+
+   void chunked_sequence::insert(const value_type& entry)
+   {
+       if (!is_item())
+       {
+           start();
+       }
+       insert_at(current_chunk, current_offset, entry);
+   }
+
+   void chunked_sequence::attach(const value_type& entry)
+   {
+       if (is_item())
+       {
+           insert_at(current_chunk, current_offset + 1, entry);
+           current_index = current_index + 1;
+       }
+       else if (chunk_count == 0)
+       {
+           insert_at(0, 0, entry);
+           current_index = 0;
+       }
+       else
+       {
+           insert_at(chunk_count - 1, chunks[chunk_count - 1]->count, entry);
+           current_index = used - 1;
+       }
+   }
+
+   void chunked_sequence::remove_current()
+   {
+      if (!is_item())
+      {
+          return;
+      }
+
+      chunk* here = chunks[current_chunk];
+      for (size_type i = current_offset + 1; i < here->count; i++)
+      {
+          here->items[i - 1] = here->items[i];
+      }
+      here->count = here->count - 1;
+      used = used - 1;
+
+      if (here->count == 0)
+      {
+          // the next chunk (if any) now holds the current item
+          erase_chunk(current_chunk);
+          current_offset = 0;
+          return;
+      }
+
+      chunk* next = (current_chunk + 1 < chunk_count)
+                    ? chunks[current_chunk + 1] : 0;
+      chunk* prev = (current_chunk > 0) ? chunks[current_chunk - 1] : 0;
+      if (next != 0 && here->count + next->count <= CHUNK_CAPACITY / 2)
+      {
+          for (size_type i = 0; i < next->count; i++)
+          {
+              here->items[here->count + i] = next->items[i];
+          }
+          here->count = here->count + next->count;
+          erase_chunk(current_chunk + 1);
+      }
+      else if (prev != 0 && prev->count + here->count <= CHUNK_CAPACITY / 2)
+      {
+          for (size_type i = 0; i < here->count; i++)
+          {
+              prev->items[prev->count + i] = here->items[i];
+          }
+          current_offset = current_offset + prev->count;
+          prev->count = prev->count + here->count;
+          erase_chunk(current_chunk);
+          current_chunk = current_chunk - 1;
+          here = prev;
+      }
+
+      if (current_offset == here->count)
+      {
+          // the removed item was the last of its chunk
+          current_chunk = current_chunk + 1;
+          current_offset = 0;
+      }
+   }
+
+   void chunked_sequence::seek(size_type index)
+   {
+       assert(index <= used);
+       current_index = index;
+       current_chunk = 0;
+       while (current_chunk < chunk_count
+              && index >= chunks[current_chunk]->count)
+       {
+           index = index - chunks[current_chunk]->count;
+           current_chunk = current_chunk + 1;
+       }
+       current_offset = index;
+   }
+
+   chunked_sequence& chunked_sequence::operator=(const chunked_sequence& source)
+   {
+      if (this != &source)
+      {
+          size_type new_table_capacity =
+             (source.chunk_count > 0) ? source.chunk_count : 1;
+          chunk** temp = copy_table(source, new_table_capacity);
+          for (size_type i = 0; i < chunk_count; i++)
+          {
+              delete chunks[i];
+          }
+          delete [] chunks;
+
+          chunks = temp;
+          table_capacity = new_table_capacity;
+          chunk_count = source.chunk_count;
+          used = source.used;
+          current_index = source.current_index;
+          current_chunk = source.current_chunk;
+          current_offset = source.current_offset;
+      }
+
+      return *this;
+   }
+
+   chunked_sequence::chunk** chunked_sequence::copy_table(
+      const chunked_sequence& source, size_type table_capacity)
+   {
+       chunk** table = new chunk*[table_capacity];
+       for (size_type i = 0; i < source.chunk_count; i++)
+       {
+           const chunk* from = source.chunks[i];
+           table[i] = new chunk;
+           table[i]->count = from->count;
+           for (size_type j = 0; j < from->count; j++)
+           {
+               table[i]->items[j] = from->items[j];
+           }
+       }
+       return table;
+   }
+
+   void chunked_sequence::resize_table(size_type new_table_capacity)
+   {
+       chunk** temp = new chunk*[new_table_capacity];
+       for (size_type i = 0; i < chunk_count; i++)
+       {
+           temp[i] = chunks[i];
+       }
+       delete [] chunks;
+       chunks = temp;
+       table_capacity = new_table_capacity;
+   }
+
+   void chunked_sequence::insert_chunk(size_type at)
+   {
+       if (chunk_count == table_capacity)
+       {
+           resize_table(2 * table_capacity);
+       }
+       for (size_type i = chunk_count; i > at; i--)
+       {
+           chunks[i] = chunks[i - 1];
+       }
+       chunks[at] = new chunk;
+       chunks[at]->count = 0;
+       chunk_count = chunk_count + 1;
+   }
+
+   void chunked_sequence::erase_chunk(size_type at)
+   {
+       delete chunks[at];
+       for (size_type i = at + 1; i < chunk_count; i++)
+       {
+           chunks[i - 1] = chunks[i];
+       }
+       chunk_count = chunk_count - 1;
+   }
+
+   void chunked_sequence::insert_at(size_type at, size_type offset,
+                                    const value_type& entry)
+   {
+       if (chunk_count == 0)
+       {
+           insert_chunk(0);
+       }
+       else if (chunks[at]->count == CHUNK_CAPACITY)
+       {
+           if (offset == CHUNK_CAPACITY)
+           {
+               // start a new chunk after the full one
+               insert_chunk(at + 1);
+               at = at + 1;
+               offset = 0;
+           }
+           else if (offset == 0)
+           {
+               // start a new chunk before the full one
+               insert_chunk(at);
+           }
+           else
+           {
+               // split: the upper half moves to a new chunk
+               size_type half = CHUNK_CAPACITY / 2;
+               insert_chunk(at + 1);
+               chunk* lower = chunks[at];
+               chunk* upper = chunks[at + 1];
+               for (size_type i = half; i < CHUNK_CAPACITY; i++)
+               {
+                   upper->items[i - half] = lower->items[i];
+               }
+               upper->count = CHUNK_CAPACITY - half;
+               lower->count = half;
+               if (offset > half)
+               {
+                   at = at + 1;
+                   offset = offset - half;
+               }
+           }
+       }
+
+       chunk* here = chunks[at];
+       for (size_type i = here->count; i > offset; i--)
+       {
+           here->items[i] = here->items[i - 1];
+       }
+       here->items[offset] = entry;
+       here->count = here->count + 1;
+       used = used + 1;
+       current_chunk = at;
+       current_offset = offset;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   chunked_sequence::size_type chunked_sequence::size() const
+   {
+       return used;
+   }
+
+   bool chunked_sequence::is_item() const
+   {
+       return current_index < used;
+   }
+
+   chunked_sequence::value_type chunked_sequence::current() const
+   {
+       assert(is_item());
+       return chunks[current_chunk]->items[current_offset];
+   }
+}
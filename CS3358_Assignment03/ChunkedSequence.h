@@ -0,0 +1,122 @@
+// FILE: ChunkedSequence.h
+// CLASS PROVIDED: chunked_sequence (part of the namespace CS3358_FA2017)
+//
+// A chunked_sequence is a sequence (see Sequence.h) with the same
+// public interface and behavior, plus seek, meant for sequences of
+// millions of items edited at many different places. The items are
+// kept in fixed-size chunks of CHUNK_CAPACITY items each (an unrolled
+// list): a table of pointers holds the chunks in order, and the cursor
+// remembers both the index of the current item and the chunk and
+// place in the chunk it is at. So
+//   - start, advance, is_item and current take O(1) time;
+//   - insert, attach and remove_current only shift the items of one
+//     chunk, splitting a full chunk in two (or merging a chunk with a
+//     neighbor once the two are at most half full) and then shifting
+//     the chunk pointers after it: O(CHUNK_CAPACITY + n / CHUNK_CAPACITY)
+//     time, i.e. O(sqrt(n)) for n up to a few million items, where
+//     sequence shifts the whole tail;
+//   - seek makes any item current in O(n / CHUNK_CAPACITY) time.
+// Memory grows a chunk at a time, so there is never a copy of all the
+// items when the sequence grows.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the chunked_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   static const size_type DEFAULT_CAPACITY = _____
+//    As for sequence.
+//
+//   static const size_type CHUNK_CAPACITY = _____
+//    chunked_sequence::CHUNK_CAPACITY is the number of items a chunk
+//    holds (chunks of 4 KB for double).
+//
+// CONSTRUCTOR for the chunked_sequence class:
+//   chunked_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  initial_capacity > 0
+//    Post: The chunked_sequence has been initialized as an empty
+//      sequence, with room in the chunk table for initial_capacity
+//      items (chunks themselves are only allocated as items arrive).
+//    Note: If Pre is not met, initial_capacity will be adjusted to 1.
+//
+// MODIFICATION MEMBER FUNCTIONS for the chunked_sequence class:
+//   void resize(size_type new_capacity)
+//    Pre:  new_capacity > 0
+//    Post: The chunk table has room for new_capacity items (but never
+//      less than the chunks already in use); no chunk is allocated,
+//      freed or copied.
+//
+//   void start()
+//   void advance()
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//    Same as for sequence (see Sequence.h).
+//
+//   void seek(size_type index)
+//    Pre:  index <= size()
+//    Post: Item index (counting from 0 at the front) is now the current
+//      item; if index == size(), there is no current item.
+//
+// CONSTANT MEMBER FUNCTIONS for the chunked_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    Same as for sequence (see Sequence.h); each takes O(1) time.
+//
+// VALUE SEMANTICS for the chunked_sequence class:
+//   Assignments and the copy constructor may be used with
+//   chunked_sequence objects.
+
+#ifndef CHUNKED_SEQUENCE_H
+#define CHUNKED_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2017
+{
+   class chunked_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type CHUNK_CAPACITY = 512;
+      // CONSTRUCTORS and DESTRUCTOR
+      chunked_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      chunked_sequence(const chunked_sequence& source);
+      ~chunked_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void seek(size_type index);
+      chunked_sequence& operator=(const chunked_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct chunk
+      {
+         size_type count;
+         value_type items[CHUNK_CAPACITY];
+      };
+      chunk** chunks;
+      size_type chunk_count;
+      size_type table_capacity;
+      size_type used;
+      size_type current_index;
+      size_type current_chunk;
+      size_type current_offset;
+      static chunk** copy_table(const chunked_sequence& source,
+                                size_type table_capacity);
+      void resize_table(size_type new_table_capacity);
+      void insert_chunk(size_type at);
+      void erase_chunk(size_type at);
+      void insert_at(size_type at, size_type offset, const value_type& entry);
+   };
+}
+
+#endif
@@ -0,0 +1,240 @@
+// FILE: GapSequence.cpp
+// CLASS IMPLEMENTED: gap_sequence (see GapSequence.h for documentation)
+// INVARIANT for the gap_sequence ADT:
+//   1. The number of items in the sequence is in the member variable
+//      used, and the size of the dynamic array pointed to by the member
+//      variable data is in the member variable capacity.
+//   2. The unused part of the array is one run of slots, the gap,
+//      data[gap_start] through data[gap_end - 1] (gap_end - gap_start
+//      == capacity - used; the gap is empty when the array is full).
+//      The items of the sequence are stored, in order, in data[0]
+//      through data[gap_start - 1] followed by data[gap_end] through
+//      data[capacity - 1]; so item i is in data[i] if i < gap_start,
+//      otherwise in data[i + (gap_end - gap_start)]. We don't care
+//      what's in the gap.
+//   3. The index (0 for the first item, as above) of the current item
+//      is in the member variable current_index; if there is no valid
+//      current item, current_index is the same number as used (see
+//      Sequence.cpp for why).
+//   The gap is only moved when an edit needs it somewhere else: it is
+//   left where the last insert, attach or remove_current put it.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   void move_gap(size_type index)
+//    Pre:  index <= used
+//    Post: The gap has been moved so that gap_start == index (the
+//      items between the old and the new place of the gap have been
+//      copied across it); the sequence is unchanged.
+//   void insert_at(size_type index, const value_type& entry)
+//    Pre:  index <= used
+//    Post: A copy of entry has been inserted so that it is item index
+//      of the sequence (growing the array by a factor of 1.25 if it
+//      was full); current_index is unchanged.
+
+#include <cassert>
+#include "GapSequence.h"
+using namespace std;
+
+namespace CS3358_FA2017
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   gap_sequence::gap_sequence(size_type initial_capacity)
+      : used(0), current_index(0), capacity(initial_capacity), gap_start(0)
+   {
+       if (capacity < 1)
+       {
+           capacity = 1;
+       }
+       data = new value_type[capacity];
+       gap_end = capacity;
+   }
+
+   gap_sequence::gap_sequence(const gap_sequence& source)
+      : used(source.used), current_index(source.current_index),
+        capacity(source.capacity), gap_start(source.gap_start),
+        gap_end(source.gap_end)
+   {
+       data = new value_type[capacity];
+       for (size_type i = 0; i < gap_start; i++)
+       {
+           data[i] = source.data[i];
+       }
+       for (size_type i = gap_end; i < capacity; i++)
+       {
+           data[i] = source.data[i];
+       }
+   }
+
+   gap_sequence::~gap_sequence()
+   {
+       delete [] data;
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void gap_sequence::resize(size_type new_capacity)
+   {
+       if (new_capacity < used)
+       {
+           new_capacity = used;
+       }
+       if (new_capacity < 1)
+       {
+           new_capacity = 1;
+       }
+       if (new_capacity == capacity)
+       {
+           return;
+       }
+       value_type* temp = new value_type[new_capacity];
+
+       // the gap stays where it is (and takes up the change in size)
+       size_type after = capacity - gap_end;
+       for (size_type i = 0; i < gap_start; i++)
+       {
+           temp[i] = data[i];
+       }
+       for (size_type i = 0; i < after; i++)
+       {
+           temp[new_capacity - after + i] = data[gap_end + i];
+       }
+
+       delete [] data;
+       data = temp;
+       capacity = new_capacity;
+       gap_end = capacity - after;
+   }
+
+   void gap_sequence::start()
+   {
+       current_index = 0;
+   }
+
+   void gap_sequence::advance()
+   {
+       if (is_item())
+       {
+           current_index = current_index + 1;
+       }
+   }
+
+   void gap_sequence::insert(const value_type& entry)
+   {
+       if (!is_item())
+       {
+           start();
+       }
+       insert_at(current_index, entry);
+   }
+
+   void gap_sequence::attach(const value_type& entry)
+   {
+       if (is_item())
+       {
+           insert_at(current_index + 1, entry);
+           advance();
+       }
+       else
+       {
+           insert_at(used, entry);
+       }
+   }
+
+   void gap_sequence::remove_current()
+   {
+      if (is_item())
+      {
+          // the gap swallows the current item
+          move_gap(current_index);
+          gap_end = gap_end + 1;
+          used = used - 1;
+      }
+   }
+
+   gap_sequence& gap_sequence::operator=(const gap_sequence& source)
+   {
+      if (this != &source)
+      {
+          value_type* temp = new value_type[source.capacity];
+          for (size_type i = 0; i < source.gap_start; i++)
+          {
+              temp[i] = source.data[i];
+          }
+          for (size_type i = source.gap_end; i < source.capacity; i++)
+          {
+              temp[i] = source.data[i];
+          }
+          delete [] data;
+
+          data = temp;
+          capacity = source.capacity;
+          used = source.used;
+          current_index = source.current_index;
+          gap_start = source.gap_start;
+          gap_end = source.gap_end;
+      }
+
+      return *this;
+   }
+
+   void gap_sequence::move_gap(size_type index)
+   {
+       if (index < gap_start)
+       {
+           // items index .. gap_start - 1 move to the end of the gap
+           while (gap_start > index)
+           {
+               gap_start = gap_start - 1;
+               gap_end = gap_end - 1;
+               data[gap_end] = data[gap_start];
+           }
+       }
+       else
+       {
+           // items after the gap move to its start, up to index
+           while (gap_start < index)
+           {
+               data[gap_start] = data[gap_end];
+               gap_start = gap_start + 1;
+               gap_end = gap_end + 1;
+           }
+       }
+   }
+
+   void gap_sequence::insert_at(size_type index, const value_type& entry)
+   {
+       if (gap_start == gap_end)
+       {
+           size_type new_capacity = size_type(capacity * 1.25);
+           if (new_capacity == capacity)
+           {
+               new_capacity = capacity + 1;
+           }
+           resize(new_capacity);
+       }
+       move_gap(index);
+       data[gap_start] = entry;
+       gap_start = gap_start + 1;
+       used = used + 1;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   gap_sequence::size_type gap_sequence::size() const
+   {
+       return used;
+   }
+
+   bool gap_sequence::is_item() const
+   {
+       return current_index < used;
+   }
+
+   gap_sequence::value_type gap_sequence::current() const
+   {
+       assert(is_item());
+       if (current_index < gap_start)
+       {
+           return data[current_index];
+       }
+       return data[current_index + (gap_end - gap_start)];
+   }
+}
@@ -0,0 +1,91 @@
+// FILE: GapSequence.h
+// CLASS PROVIDED: gap_sequence (part of the namespace CS3358_FA2017)
+//
+// A gap_sequence is a sequence (see Sequence.h) with exactly the same
+// public interface and behavior, stored as a gap buffer: the items
+// are kept in one dynamic array with the unused capacity (the "gap")
+// kept at the place of the most recent edit rather than at the end.
+// Inserting, attaching or removing at the cursor only moves the gap
+// there (copying the items between its old and new place) and then
+// takes or gives back one slot of the gap, so a run of edits at (or
+// moving steadily along with) the cursor takes amortized O(1) time
+// per edit, where sequence shifts every item after the cursor on each
+// edit. Editing at a cursor far from the previous edit costs the
+// distance between the two.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the gap_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   static const size_type DEFAULT_CAPACITY = _____
+//    As for sequence.
+//
+// CONSTRUCTOR for the gap_sequence class:
+//   gap_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  initial_capacity > 0
+//    Post: The gap_sequence has been initialized as an empty sequence.
+//      The insert/attach functions will work efficiently (without
+//      allocating new memory) until this capacity is reached.
+//    Note: If Pre is not met, initial_capacity will be adjusted to 1.
+//
+// MODIFICATION MEMBER FUNCTIONS for the gap_sequence class:
+//   void resize(size_type new_capacity)
+//   void start()
+//   void advance()
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//    Same as for sequence (see Sequence.h); when the array is full,
+//    insert and attach grow the capacity by a factor of 1.25.
+//
+// CONSTANT MEMBER FUNCTIONS for the gap_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    Same as for sequence (see Sequence.h); each takes O(1) time.
+//
+// VALUE SEMANTICS for the gap_sequence class:
+//   Assignments and the copy constructor may be used with gap_sequence
+//   objects.
+
+#ifndef GAP_SEQUENCE_H
+#define GAP_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2017
+{
+   class gap_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      // CONSTRUCTORS and DESTRUCTOR
+      gap_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      gap_sequence(const gap_sequence& source);
+      ~gap_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      gap_sequence& operator=(const gap_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      value_type* data;
+      size_type used;
+      size_type current_index;
+      size_type capacity;
+      size_type gap_start;
+      size_type gap_end;
+      void move_gap(size_type index);
+      void insert_at(size_type index, const value_type& entry);
+   };
+}
+
+#endif
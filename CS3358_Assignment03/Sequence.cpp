@@ -10,7 +10,9 @@
 //      the items in the sequence are stored in data[0] through
 //      data[used-1], and we don't care what's in the rest of data.
 //   3. The size of the dynamic array is in the member variable
-//      capacity.
+//      capacity. The array was got from the memory_resource pointed to
+//      by the member variable resource (with make_array), and goes back
+//      to it (with free_array).
 //   4. The index of the current item is in the member variable
 //      current_index. If there is no valid current item, then
 //      current_index will be set to the same number as used.
@@ -37,41 +39,408 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//
+// DOCUMENTATION for private member (helper) functions:
+//   value_type* make_array(size_type n)
+//    Pre:  none
+//    Post: An array of n default-initialized items, got from resource,
+//      is returned (as new value_type[n] would, but from resource).
+//   void free_array(value_type* items, size_type n)
+//    Pre:  items was returned by make_array(n) and not freed since.
+//    Post: The items have been destroyed and their memory given back to
+//      resource.
+//   void open_gap(size_type index, size_type count)
+//    Pre:  index <= used
+//    Post: data[index] through data[index + count - 1] are free for
+//      count new items: the items from index on have been moved up
+//      count places (used is unchanged). If the array was too small it
+//      has been replaced, once, by one of capacity used + count (or
+//      1.25 times the old capacity, if that is larger), copying each
+//      item straight to its new place.
+//
+// Items are shifted (and copied in blocks) with move_items, which uses
+// memmove when value_type is a built-in arithmetic type (chosen at
+// compile time by is_memmovable) and an assignment loop otherwise.
+//
+// The reductions run over data[0] through data[used - 1] with the
+// kernels below, written once over an "ops" class (scalar_ops,
+// sse2_ops or avx_ops) that wraps the vector type and instructions;
+// simd_ops is the widest one the compiler targets. Each kernel adds up
+// a "term" per item (the item, its product with an item of another
+// sequence, or its squared difference from the mean), a vector of
+// terms at a time.
 
 #include <cassert>
+#include <cstring>
+#include <new>      // provides placement new
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "Sequence.h"
 #include <iostream>
 using namespace std;
 
 namespace CS3358_FA2017
 {
+   namespace
+   {
+      // is_memmovable<V>::value is true when copies of V items can be
+      // made by copying their bytes: true for the built-in arithmetic
+      // types, false (to be safe) for anything else.
+      template <class V> struct is_memmovable { enum { value = false }; };
+      template <> struct is_memmovable<char> { enum { value = true }; };
+      template <> struct is_memmovable<short> { enum { value = true }; };
+      template <> struct is_memmovable<int> { enum { value = true }; };
+      template <> struct is_memmovable<long> { enum { value = true }; };
+      template <> struct is_memmovable<unsigned char> { enum { value = true }; };
+      template <> struct is_memmovable<unsigned short> { enum { value = true }; };
+      template <> struct is_memmovable<unsigned int> { enum { value = true }; };
+      template <> struct is_memmovable<unsigned long> { enum { value = true }; };
+      template <> struct is_memmovable<float> { enum { value = true }; };
+      template <> struct is_memmovable<double> { enum { value = true }; };
+      template <> struct is_memmovable<long double> { enum { value = true }; };
+
+      template <bool> struct memmovable_tag { };
+
+      // Pre:  dest and source each point to count items (the two runs
+      //       may overlap).
+      // Post: The items source pointed to have been copied, in order,
+      //       to dest (as though through a temporary array).
+      template <class V>
+      void move_items(V* dest, const V* source, size_t count,
+                      memmovable_tag<true>)
+      {
+         memmove(dest, source, count * sizeof(V));
+      }
+
+      template <class V>
+      void move_items(V* dest, const V* source, size_t count,
+                      memmovable_tag<false>)
+      {
+         if (dest < source)
+         {
+            for (size_t i = 0; i < count; i++)
+               dest[i] = source[i];
+         }
+         else
+         {
+            for (size_t i = count; i > 0; i--)
+               dest[i - 1] = source[i - 1];
+         }
+      }
+
+      template <class V>
+      void move_items(V* dest, const V* source, size_t count)
+      {
+         move_items(dest, source, count,
+                    memmovable_tag<is_memmovable<V>::value>());
+      }
+
+      // The ops classes: vec holds WIDTH doubles, and each function
+      // does to every lane what its name says (hsum adds up the lanes;
+      // load and store take unaligned pointers).
+      struct scalar_ops
+      {
+         typedef double vec;
+         enum { WIDTH = 1 };
+         static vec zero() { return 0.0; }
+         static vec set1(double x) { return x; }
+         static vec load(const double* p) { return *p; }
+         static void store(double* p, vec v) { *p = v; }
+         static vec add(vec a, vec b) { return a + b; }
+         static vec sub(vec a, vec b) { return a - b; }
+         static vec mul(vec a, vec b) { return a * b; }
+         static vec min(vec a, vec b) { return (b < a) ? b : a; }
+         static vec max(vec a, vec b) { return (a < b) ? b : a; }
+      };
+
+#if defined(__SSE2__)
+      struct sse2_ops
+      {
+         typedef __m128d vec;
+         enum { WIDTH = 2 };
+         static vec zero() { return _mm_setzero_pd(); }
+         static vec set1(double x) { return _mm_set1_pd(x); }
+         static vec load(const double* p) { return _mm_loadu_pd(p); }
+         static void store(double* p, vec v) { _mm_storeu_pd(p, v); }
+         static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+         static vec sub(vec a, vec b) { return _mm_sub_pd(a, b); }
+         static vec mul(vec a, vec b) { return _mm_mul_pd(a, b); }
+         static vec min(vec a, vec b) { return _mm_min_pd(a, b); }
+         static vec max(vec a, vec b) { return _mm_max_pd(a, b); }
+      };
+#endif
+
+#if defined(__AVX__)
+      struct avx_ops
+      {
+         typedef __m256d vec;
+         enum { WIDTH = 4 };
+         static vec zero() { return _mm256_setzero_pd(); }
+         static vec set1(double x) { return _mm256_set1_pd(x); }
+         static vec load(const double* p) { return _mm256_loadu_pd(p); }
+         static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+         static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+         static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+         static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+         static vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+         static vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+      };
+      typedef avx_ops simd_ops;
+#elif defined(__SSE2__)
+      typedef sse2_ops simd_ops;
+#else
+      typedef scalar_ops simd_ops;
+#endif
+
+      // The terms: at<Ops>(i) is the vector of the terms for items i
+      // through i + Ops::WIDTH - 1.
+      struct item_term
+      {
+         const double* x;
+         template <class Ops>
+         typename Ops::vec at(size_t i) const
+         {
+            return Ops::load(x + i);
+         }
+      };
+
+      struct product_term
+      {
+         const double* x;
+         const double* y;
+         template <class Ops>
+         typename Ops::vec at(size_t i) const
+         {
+            return Ops::mul(Ops::load(x + i), Ops::load(y + i));
+         }
+      };
+
+      struct deviation_term
+      {
+         const double* x;
+         double mean;
+         template <class Ops>
+         typename Ops::vec at(size_t i) const
+         {
+            typename Ops::vec d = Ops::sub(Ops::load(x + i),
+                                           Ops::set1(mean));
+            return Ops::mul(d, d);
+         }
+      };
+
+      // Adds v's lanes to total, Kahan style (comp is total's
+      // compensation).
+      template <class Ops>
+      void kahan_add_lanes(typename Ops::vec v, double& total, double& comp)
+      {
+         double lanes[Ops::WIDTH];
+         Ops::store(lanes, v);
+         for (int k = 0; k < Ops::WIDTH; k++)
+         {
+            double y = lanes[k] - comp;
+            double t = total + y;
+            comp = (t - total) - y;
+            total = t;
+         }
+      }
+
+      // Pre:  first <= last, and term has terms for items first through
+      //       last - 1.
+      // Post: The sum of those terms is returned. (Four running sums
+      //       hide the latency of the adds.)
+      template <class Ops, class Term>
+      double plain_sum(const Term& term, size_t first, size_t last)
+      {
+         const size_t STEP = Ops::WIDTH;
+         typename Ops::vec a0 = Ops::zero(), a1 = Ops::zero(),
+                           a2 = Ops::zero(), a3 = Ops::zero();
+         size_t i = first;
+         for ( ; i + 4 * STEP <= last; i += 4 * STEP)
+         {
+            a0 = Ops::add(a0, term.template at<Ops>(i));
+            a1 = Ops::add(a1, term.template at<Ops>(i + STEP));
+            a2 = Ops::add(a2, term.template at<Ops>(i + 2 * STEP));
+            a3 = Ops::add(a3, term.template at<Ops>(i + 3 * STEP));
+         }
+         for ( ; i + STEP <= last; i += STEP)
+         {
+            a0 = Ops::add(a0, term.template at<Ops>(i));
+         }
+         double lanes[Ops::WIDTH];
+         Ops::store(lanes, Ops::add(Ops::add(a0, a1), Ops::add(a2, a3)));
+         double total = 0.0;
+         for (int k = 0; k < Ops::WIDTH; k++)
+         {
+            total += lanes[k];
+         }
+         for ( ; i < last; i++)
+         {
+            total += term.template at<scalar_ops>(i);
+         }
+         return total;
+      }
+
+      // Adds v to sum, Kahan style, lane by lane.
+      template <class Ops>
+      void kahan_add(typename Ops::vec v, typename Ops::vec& sum,
+                     typename Ops::vec& comp)
+      {
+         typename Ops::vec y = Ops::sub(v, comp);
+         typename Ops::vec t = Ops::add(sum, y);
+         comp = Ops::sub(Ops::sub(t, sum), y);
+         sum = t;
+      }
+
+      // Pre and Post: as for plain_sum, but each lane of two running
+      // sums keeps a Kahan compensation term, and the lanes and the
+      // leftover terms are added in with compensation too.
+      template <class Ops, class Term>
+      double kahan_sum(const Term& term, size_t first, size_t last)
+      {
+         const size_t STEP = Ops::WIDTH;
+         typename Ops::vec s0 = Ops::zero(), c0 = Ops::zero(),
+                           s1 = Ops::zero(), c1 = Ops::zero();
+         size_t i = first;
+         for ( ; i + 2 * STEP <= last; i += 2 * STEP)
+         {
+            kahan_add<Ops>(term.template at<Ops>(i), s0, c0);
+            kahan_add<Ops>(term.template at<Ops>(i + STEP), s1, c1);
+         }
+         for ( ; i + STEP <= last; i += STEP)
+         {
+            kahan_add<Ops>(term.template at<Ops>(i), s0, c0);
+         }
+         double total = 0.0, total_comp = 0.0;
+         kahan_add_lanes<Ops>(s0, total, total_comp);
+         kahan_add_lanes<Ops>(s1, total, total_comp);
+         kahan_add_lanes<Ops>(Ops::sub(Ops::zero(), c0), total, total_comp);
+         kahan_add_lanes<Ops>(Ops::sub(Ops::zero(), c1), total, total_comp);
+         for ( ; i < last; i++)
+         {
+            kahan_add_lanes<scalar_ops>(term.template at<scalar_ops>(i),
+                                        total, total_comp);
+         }
+         return total;
+      }
+
+      // Pre and Post: as for plain_sum, but the range is halved until
+      // it is at most PAIRWISE_BLOCK terms, which plain_sum adds up.
+      const size_t PAIRWISE_BLOCK = 128;
+
+      template <class Ops, class Term>
+      double pairwise_sum(const Term& term, size_t first, size_t last)
+      {
+         if (last - first <= PAIRWISE_BLOCK)
+         {
+            return plain_sum<Ops>(term, first, last);
+         }
+         size_t middle = first + (last - first) / 2;
+         return pairwise_sum<Ops>(term, first, middle)
+                + pairwise_sum<Ops>(term, middle, last);
+      }
+
+      template <class Term>
+      double sum_terms(const Term& term, size_t count,
+                       sequence::summation method)
+      {
+         switch (method)
+         {
+            case sequence::KAHAN_SUM:
+               return kahan_sum<simd_ops>(term, 0, count);
+            case sequence::PAIRWISE_SUM:
+               return pairwise_sum<simd_ops>(term, 0, count);
+            default:
+               return plain_sum<simd_ops>(term, 0, count);
+         }
+      }
+
+      // Pre:  count > 0
+      // Post: The smallest (smallest_item) or largest (largest_item) of
+      //       x[0] through x[count - 1] is returned.
+      template <class Ops>
+      double smallest_item(const double* x, size_t count)
+      {
+         const size_t STEP = Ops::WIDTH;
+         double best = x[0];
+         size_t i = 0;
+         if (count >= 2 * STEP)
+         {
+            typename Ops::vec b0 = Ops::load(x), b1 = Ops::load(x + STEP);
+            for (i = 2 * STEP; i + 2 * STEP <= count; i += 2 * STEP)
+            {
+               b0 = Ops::min(b0, Ops::load(x + i));
+               b1 = Ops::min(b1, Ops::load(x + i + STEP));
+            }
+            double lanes[Ops::WIDTH];
+            Ops::store(lanes, Ops::min(b0, b1));
+            for (int k = 0; k < Ops::WIDTH; k++)
+            {
+               best = scalar_ops::min(best, lanes[k]);
+            }
+         }
+         for ( ; i < count; i++)
+         {
+            best = scalar_ops::min(best, x[i]);
+         }
+         return best;
+      }
+
+      template <class Ops>
+      double largest_item(const double* x, size_t count)
+      {
+         const size_t STEP = Ops::WIDTH;
+         double best = x[0];
+         size_t i = 0;
+         if (count >= 2 * STEP)
+         {
+            typename Ops::vec b0 = Ops::load(x), b1 = Ops::load(x + STEP);
+            for (i = 2 * STEP; i + 2 * STEP <= count; i += 2 * STEP)
+            {
+               b0 = Ops::max(b0, Ops::load(x + i));
+               b1 = Ops::max(b1, Ops::load(x + i + STEP));
+            }
+            double lanes[Ops::WIDTH];
+            Ops::store(lanes, Ops::max(b0, b1));
+            for (int k = 0; k < Ops::WIDTH; k++)
+            {
+               best = scalar_ops::max(best, lanes[k]);
+            }
+         }
+         for ( ; i < count; i++)
+         {
+            best = scalar_ops::max(best, x[i]);
+         }
+         return best;
+      }
+   }
+
    // CONSTRUCTORS and DESTRUCTOR
-    sequence::sequence(size_type initial_capacity) : used(0), current_index(0), capacity(initial_capacity)
+    sequence::sequence(size_type initial_capacity, memory_resource* resource) : used(0), current_index(0), capacity(initial_capacity), resource(resource)
    {
        if (initial_capacity < 1)
        {
            capacity = DEFAULT_CAPACITY;
        }
-       capacity = initial_capacity;
-       data = new value_type[capacity];
+       data = make_array(capacity);
    }
 
-   sequence::sequence(const sequence& source)
+   sequence::sequence(const sequence& source, memory_resource* resource)
+      : resource(resource)
    {
-       data = new value_type[source.capacity];
+       data = make_array(source.capacity);
        capacity = source.capacity;
        used = source.used;
        current_index = source.current_index;
        
-       for (size_type i = 0; i < source.used; i++)
-       {
-           data[i] = source.data[i];
-       }
+       move_items(data, source.data, used);
    }
 
    sequence::~sequence()
    {
-       delete [] data;
+       free_array(data, capacity);
    }
 
    // MODIFICATION MEMBER FUNCTIONS
@@ -85,16 +454,13 @@ namespace CS3358_FA2017
        {
            new_capacity = 1;
        }
-       capacity = new_capacity;
-       value_type* temp = new value_type[capacity];
+       value_type* temp = make_array(new_capacity);
        
-       for (size_type i = 0; i < used; i++)
-       {
-           temp[i] = data[i];
-       }
+       move_items(temp, data, used);
        
-       delete [] data;
+       free_array(data, capacity);
        data = temp;
+       capacity = new_capacity;
    }
 
    void sequence::start()
@@ -123,10 +489,8 @@ namespace CS3358_FA2017
        }
        if (is_item())
        {
-           for (size_type i = used; i > current_index; i--)
-           {
-               data[i] = data[i - 1];
-           }
+           move_items(data + current_index + 1, data + current_index,
+                      used - current_index);
            data[current_index] = entry;
            used = used + 1;
        }
@@ -135,10 +499,7 @@ namespace CS3358_FA2017
            if (current_index > 0)
            {
                start();
-               for (size_type i = used; i > current_index; i--)
-               {
-                   data[i] = data[i - 1];
-               }
+               move_items(data + 1, data, used);
                data[current_index] = entry;
                used = used + 1;
            }
@@ -163,10 +524,8 @@ namespace CS3358_FA2017
        }
        if (is_item())
        {
-           for (size_type i = used; i > current_index + 1; i--)
-           {
-               data[i] = data[i - 1];
-           }
+           move_items(data + current_index + 2, data + current_index + 1,
+                      used - current_index - 1);
            advance();
            data[current_index] = entry;
            used = used + 1;
@@ -178,6 +537,36 @@ namespace CS3358_FA2017
        }
    }
 
+   void sequence::insert_range(const value_type* first, const value_type* last)
+   {
+       size_type count = last - first;
+       if (count == 0)
+       {
+           return;
+       }
+       if (!is_item())
+       {
+           start();
+       }
+       open_gap(current_index, count);
+       move_items(data + current_index, first, count);
+       used = used + count;
+   }
+
+   void sequence::attach_range(const value_type* first, const value_type* last)
+   {
+       size_type count = last - first;
+       if (count == 0)
+       {
+           return;
+       }
+       size_type index = is_item() ? current_index + 1 : used;
+       open_gap(index, count);
+       move_items(data + index, first, count);
+       used = used + count;
+       current_index = index + count - 1;
+   }
+
    void sequence::remove_current()
    {
       if (is_item())
@@ -188,10 +577,8 @@ namespace CS3358_FA2017
           }
           else
           {
-              for (size_type i = current_index; i < used - 1; ++i)
-              {
-                  data[i] = data[i + 1];
-              }
+              move_items(data + current_index, data + current_index + 1,
+                         used - current_index - 1);
               used = used - 1;
           }
       }
@@ -201,12 +588,9 @@ namespace CS3358_FA2017
    {
       if (this != &source)
       {
-          value_type* temp = new value_type[source.capacity];
-          for (size_type i = 0; i < source.used; i++)
-          {
-              temp[i] = source.data[i];
-          }
-          delete [] data;
+          value_type* temp = make_array(source.capacity);
+          move_items(temp, source.data, source.used);
+          free_array(data, capacity);
           
           data = temp;
           capacity = source.capacity;
@@ -217,7 +601,69 @@ namespace CS3358_FA2017
       return *this;
    }
 
+   sequence::value_type* sequence::make_array(size_type n)
+   {
+       value_type* items = static_cast<value_type*>(
+          resource->allocate(n * sizeof(value_type)));
+       size_type made = 0;
+       try
+       {
+           for ( ; made < n; made++)
+           {
+               new (items + made) value_type;
+           }
+       }
+       catch (...)
+       {
+           while (made > 0)
+           {
+               made--;
+               items[made].~value_type();
+           }
+           resource->deallocate(items, n * sizeof(value_type));
+           throw;
+       }
+       return items;
+   }
+
+   void sequence::free_array(value_type* items, size_type n)
+   {
+       for (size_type i = 0; i < n; i++)
+       {
+           items[i].~value_type();
+       }
+       resource->deallocate(items, n * sizeof(value_type));
+   }
+
+   void sequence::open_gap(size_type index, size_type count)
+   {
+       size_type after = used - index;
+       if (used + count > capacity)
+       {
+           size_type new_capacity = (capacity * 1.25);
+           if (new_capacity < used + count)
+           {
+               new_capacity = used + count;
+           }
+           value_type* temp = make_array(new_capacity);
+           move_items(temp, data, index);
+           move_items(temp + index + count, data + index, after);
+           free_array(data, capacity);
+           data = temp;
+           capacity = new_capacity;
+       }
+       else
+       {
+           move_items(data + index + count, data + index, after);
+       }
+   }
+
    // CONSTANT MEMBER FUNCTIONS
+   memory_resource* sequence::get_resource() const
+   {
+       return resource;
+   }
+
    sequence::size_type sequence::size() const
    {
        return used;
@@ -239,5 +685,211 @@ namespace CS3358_FA2017
    {
        return data[current_index];
    }
+
+   // REDUCTIONS
+   sequence::value_type sequence::sum(summation method) const
+   {
+       item_term term = { data };
+       return sum_terms(term, used, method);
+   }
+
+   sequence::value_type sequence::min() const
+   {
+       assert(used > 0);
+       return smallest_item<simd_ops>(data, used);
+   }
+
+   sequence::value_type sequence::max() const
+   {
+       assert(used > 0);
+       return largest_item<simd_ops>(data, used);
+   }
+
+   sequence::value_type sequence::mean(summation method) const
+   {
+       assert(used > 0);
+       return sum(method) / used;
+   }
+
+   sequence::value_type sequence::variance(summation method) const
+   {
+       deviation_term term = { data, mean(method) };
+       return sum_terms(term, used, method) / used;
+   }
+
+   sequence::value_type sequence::dot(const sequence& other,
+                                      summation method) const
+   {
+       assert(other.used == used);
+       product_term term = { data, other.data };
+       return sum_terms(term, used, method);
+   }
+
+   // ITERATORS and CURSORS
+   sequence::const_iterator sequence::begin() const
+   {
+       return const_iterator(this, 0);
+   }
+
+   sequence::const_iterator sequence::end() const
+   {
+       return const_iterator(this, used);
+   }
+
+   sequence::const_iterator::const_iterator() : seq(0), pos(0) { }
+
+   sequence::const_iterator::const_iterator(const sequence* owner,
+                                            size_type start)
+      : seq(owner), pos(start) { }
+
+   sequence::const_iterator::reference
+   sequence::const_iterator::operator*() const
+   {
+       return seq->data[pos];
+   }
+
+   sequence::const_iterator::pointer
+   sequence::const_iterator::operator->() const
+   {
+       return seq->data + pos;
+   }
+
+   sequence::const_iterator::reference
+   sequence::const_iterator::operator[](difference_type n) const
+   {
+       return seq->data[pos + n];
+   }
+
+   sequence::const_iterator& sequence::const_iterator::operator++()
+   {
+       pos = pos + 1;
+       return *this;
+   }
+
+   sequence::const_iterator sequence::const_iterator::operator++(int)
+   {
+       const_iterator before = *this;
+       pos = pos + 1;
+       return before;
+   }
+
+   sequence::const_iterator& sequence::const_iterator::operator--()
+   {
+       pos = pos - 1;
+       return *this;
+   }
+
+   sequence::const_iterator sequence::const_iterator::operator--(int)
+   {
+       const_iterator before = *this;
+       pos = pos - 1;
+       return before;
+   }
+
+   sequence::const_iterator&
+   sequence::const_iterator::operator+=(difference_type n)
+   {
+       pos = pos + n;
+       return *this;
+   }
+
+   sequence::const_iterator&
+   sequence::const_iterator::operator-=(difference_type n)
+   {
+       pos = pos - n;
+       return *this;
+   }
+
+   sequence::const_iterator
+   sequence::const_iterator::operator+(difference_type n) const
+   {
+       return const_iterator(seq, pos + n);
+   }
+
+   sequence::const_iterator
+   sequence::const_iterator::operator-(difference_type n) const
+   {
+       return const_iterator(seq, pos - n);
+   }
+
+   sequence::const_iterator::difference_type
+   sequence::const_iterator::operator-(const const_iterator& rhs) const
+   {
+       return difference_type(pos) - difference_type(rhs.pos);
+   }
+
+   bool sequence::const_iterator::operator==(const const_iterator& rhs) const
+   {
+       return pos == rhs.pos && seq == rhs.seq;
+   }
+
+   bool sequence::const_iterator::operator!=(const const_iterator& rhs) const
+   {
+       return !(*this == rhs);
+   }
+
+   bool sequence::const_iterator::operator<(const const_iterator& rhs) const
+   {
+       return pos < rhs.pos;
+   }
+
+   bool sequence::const_iterator::operator>(const const_iterator& rhs) const
+   {
+       return rhs.pos < pos;
+   }
+
+   bool sequence::const_iterator::operator<=(const const_iterator& rhs) const
+   {
+       return !(rhs.pos < pos);
+   }
+
+   bool sequence::const_iterator::operator>=(const const_iterator& rhs) const
+   {
+       return !(pos < rhs.pos);
+   }
+
+   sequence::const_iterator operator+(sequence::const_iterator::difference_type n,
+                                      const sequence::const_iterator& it)
+   {
+       return it + n;
+   }
+
+   sequence::cursor::cursor(const sequence& owner)
+      : seq(&owner), current_index(0) { }
+
+   void sequence::cursor::start()
+   {
+       current_index = 0;
+   }
+
+   void sequence::cursor::advance()
+   {
+       if (is_item())
+       {
+           current_index = current_index + 1;
+       }
+   }
+
+   void sequence::cursor::seek(size_type index)
+   {
+       assert(index <= seq->used);
+       current_index = index;
+   }
+
+   bool sequence::cursor::is_item() const
+   {
+       return current_index < seq->used;
+   }
+
+   sequence::value_type sequence::cursor::current() const
+   {
+       assert(is_item());
+       return seq->data[current_index];
+   }
+
+   sequence::size_type sequence::cursor::index() const
+   {
+       return current_index < seq->used ? current_index : seq->used;
+   }
 }
 
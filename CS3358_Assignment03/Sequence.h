@@ -16,13 +16,26 @@
 //    sequence::DEFAULT_CAPACITY is the default initial capacity of a
 //    sequence that is created by the default constructor.
 //
-// CONSTRUCTOR for the sequence class:
-//   sequence(size_type initial_capacity = DEFAULT_CAPACITY)
-//    Pre:  initial_capacity > 0
+// CONSTRUCTORS for the sequence class:
+//   sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//            memory_resource* resource = new_delete_resource())
+//    Pre:  initial_capacity > 0, and resource (see MemoryResource.h)
+//      outlasts the sequence.
 //    Post: The sequence has been initialized as an empty sequence.
 //      The insert/attach functions will work efficiently (without
-//      allocating new memory) until this capacity is reached.
-//    Note: If Pre is not met, initial_capacity will be adjusted to 1.
+//      allocating new memory) until this capacity is reached. All of
+//      the sequence's memory comes from resource.
+//    Note: If Pre is not met, initial_capacity will be adjusted to
+//      DEFAULT_CAPACITY.
+//
+//   sequence(const sequence& source,
+//            memory_resource* resource = new_delete_resource())
+//    Pre:  resource outlasts the sequence.
+//    Post: The sequence is a copy of source (items, current item and
+//      capacity), with its memory from resource. (As with the standard
+//      containers, a copy does not take source's memory_resource unless
+//      it is given it: a sequence copied out of an arena may outlast
+//      the arena.)
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void resize(size_type new_capacity)
@@ -63,6 +76,28 @@
 //      case, the newly inserted item is now the current item of the
 //      sequence.
 //
+//   void insert_range(const value_type* first, const value_type* last)
+//    Pre:  first <= last, and [first, last) is not part of this sequence.
+//    Post: Copies of first[0] through last[-1] have been inserted, in
+//      that order, in the sequence before the current item. If there
+//      was no current item, then they have been inserted at the front
+//      of the sequence. In either case, the first newly inserted item
+//      is now the current item (if first == last, nothing changes).
+//    Note: The capacity grows at most once (to the number of items
+//      needed, or by the usual factor of 1.25 if that is larger) and
+//      the items after the insertion point are moved only once.
+//
+//   void attach_range(const value_type* first, const value_type* last)
+//    Pre:  first <= last, and [first, last) is not part of this sequence.
+//    Post: Copies of first[0] through last[-1] have been inserted, in
+//      that order, in the sequence after the current item. If there
+//      was no current item, then they have been attached to the end of
+//      the sequence. In either case, the last newly inserted item is
+//      now the current item (if first == last, nothing changes).
+//    Note: As for insert_range; loading n items into a sequence this
+//      way takes at most one allocation and O(n) time, where n calls
+//      to attach or insert may reallocate many times.
+//
 //   void remove_current()
 //    Pre:  is_item returns true.
 //    Post: The current item has been removed from the sequence, and
@@ -71,6 +106,11 @@
 //      sequence, then there is no longer any current item.
 //
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
+//   memory_resource* get_resource() const
+//    Pre:  none
+//    Post: The memory_resource the sequence gets its memory from is
+//      returned.
+//
 //   size_type size() const
 //    Pre:  none
 //    Post: The return value is the number of items in the sequence.
@@ -86,13 +126,104 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+// REDUCTIONS for the sequence class:
+//   Each of these reads the items once, straight from the array (with
+//   no cursor and no function call per item), several at a time with
+//   the SIMD instructions the compiler targets: 4 at a time with AVX
+//   (when built with -mavx, -mavx2 or -march=native), 2 at a time with
+//   SSE2 (always there on x86-64), and one at a time otherwise. None of
+//   them changes the current item. They need value_type to be double.
+//
+//   enum summation { PLAIN_SUM, KAHAN_SUM, PAIRWISE_SUM }
+//    How the sums below are added up. PLAIN_SUM keeps several running
+//    sums and adds them at the end: the fastest, with a rounding error
+//    that may grow with the number of items. KAHAN_SUM also carries
+//    the rounding error of each addition forward (compensated
+//    summation), so the error stays about that of a single addition,
+//    at some cost in speed. PAIRWISE_SUM adds blocks of items in a
+//    balanced tree, so the error grows only as log n, at about the
+//    speed of PLAIN_SUM.
+//
+//   value_type sum(summation method = PLAIN_SUM) const
+//    Pre:  none
+//    Post: The sum of the items is returned (0 if there are none).
+//
+//   value_type min() const
+//   value_type max() const
+//    Pre:  size() > 0, and no item is NaN.
+//    Post: The smallest (largest) item is returned.
+//
+//   value_type mean(summation method = PLAIN_SUM) const
+//    Pre:  size() > 0
+//    Post: sum(method) / size() is returned.
+//
+//   value_type variance(summation method = PLAIN_SUM) const
+//    Pre:  size() > 0
+//    Post: The (population) variance of the items, the mean of the
+//      squares of their differences from mean(method), is returned.
+//    Note: This makes two passes over the items, which avoids the
+//      cancellation the one-pass (sum of squares) formula suffers.
+//
+//   value_type dot(const sequence& other,
+//                  summation method = PLAIN_SUM) const
+//    Pre:  other.size() == size()
+//    Post: The sum of the products of the items of the two sequences,
+//      item by item, is returned (0 if both are empty).
+//
+// ITERATORS and CURSORS for the sequence class:
+//   Both of these read the items of a sequence without copying it and
+//   without using (or moving) its current item, so any number of them
+//   can scan a sequence while it is being edited through its own
+//   cursor. Each holds a position (an index, 0 for the first item):
+//   inserting or removing items shifts the items but not the position,
+//   which then refers to whatever item has moved there.
+//
+//   class const_iterator
+//    A random access iterator (std::random_access_iterator_tag) over
+//    the items of a sequence, from the first to the last; *it is a
+//    const value_type&, and it supports all of the iterator arithmetic
+//    and comparisons (it + n, it - other, it[n], it < other, ...).
+//   const_iterator begin() const
+//    Pre:  none
+//    Post: An iterator to the first item is returned (end() if the
+//      sequence is empty).
+//   const_iterator end() const
+//    Pre:  none
+//    Post: The past-the-end iterator of the sequence is returned.
+//    Note: With begin() and end(), a sequence can be used with the
+//      standard algorithms (std::accumulate, std::lower_bound, ...).
+//
+//   class cursor
+//    A read-only cursor with the same interface as the sequence's own:
+//   cursor(const sequence& owner)
+//    Pre:  none
+//    Post: The cursor reads the items of owner; its current item is the
+//      first item (there is none if owner is empty).
+//   void start()
+//   void advance()
+//   bool is_item() const
+//   value_type current() const
+//    Same as for the sequence, but using the cursor's own current item.
+//   void seek(size_type index)
+//    Pre:  index <= the size of the sequence.
+//    Post: Item index is now the cursor's current item (there is none
+//      if index is the size of the sequence).
+//   size_type index() const
+//    Pre:  none
+//    Post: The index of the cursor's current item is returned (the size
+//      of the sequence if there is no current item).
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects, and with its const_iterator and cursor objects. A sequence
+//   assigned to keeps its own memory_resource.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 #include <cstdlib>  // provides size_t
+#include <cstddef>  // provides ptrdiff_t
+#include <iterator> // provides std::random_access_iterator_tag
+#include "MemoryResource.h"
 
 namespace CS3358_FA2017
 {
@@ -104,8 +235,10 @@ namespace CS3358_FA2017
       typedef std::size_t size_type;
       static const size_type DEFAULT_CAPACITY = 30;
       // CONSTRUCTORS and DESTRUCTOR
-      sequence(size_type initial_capacity = DEFAULT_CAPACITY);
-      sequence(const sequence& source);
+      sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+               memory_resource* resource = new_delete_resource());
+      sequence(const sequence& source,
+               memory_resource* resource = new_delete_resource());
       ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void resize(size_type new_capacity);
@@ -113,18 +246,90 @@ namespace CS3358_FA2017
       void advance();
       void insert(const value_type& entry);
       void attach(const value_type& entry);
+      void insert_range(const value_type* first, const value_type* last);
+      void attach_range(const value_type* first, const value_type* last);
       void remove_current();
       sequence& operator=(const sequence& source);
       // CONSTANT MEMBER FUNCTIONS
+      memory_resource* get_resource() const;
       size_type size() const;
       bool is_item() const;
       value_type current() const;
+      // REDUCTIONS
+      enum summation { PLAIN_SUM, KAHAN_SUM, PAIRWISE_SUM };
+      value_type sum(summation method = PLAIN_SUM) const;
+      value_type min() const;
+      value_type max() const;
+      value_type mean(summation method = PLAIN_SUM) const;
+      value_type variance(summation method = PLAIN_SUM) const;
+      value_type dot(const sequence& other,
+                     summation method = PLAIN_SUM) const;
+      // ITERATORS and CURSORS
+      class const_iterator
+      {
+      public:
+         typedef std::random_access_iterator_tag iterator_category;
+         typedef sequence::value_type value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const value_type* pointer;
+         typedef const value_type& reference;
+         const_iterator();
+         reference operator*() const;
+         pointer operator->() const;
+         reference operator[](difference_type n) const;
+         const_iterator& operator++();
+         const_iterator operator++(int);
+         const_iterator& operator--();
+         const_iterator operator--(int);
+         const_iterator& operator+=(difference_type n);
+         const_iterator& operator-=(difference_type n);
+         const_iterator operator+(difference_type n) const;
+         const_iterator operator-(difference_type n) const;
+         difference_type operator-(const const_iterator& rhs) const;
+         bool operator==(const const_iterator& rhs) const;
+         bool operator!=(const const_iterator& rhs) const;
+         bool operator<(const const_iterator& rhs) const;
+         bool operator>(const const_iterator& rhs) const;
+         bool operator<=(const const_iterator& rhs) const;
+         bool operator>=(const const_iterator& rhs) const;
+      private:
+         friend class sequence;
+         const sequence* seq;
+         size_type pos;
+         const_iterator(const sequence* owner, size_type start);
+      };
+      const_iterator begin() const;
+      const_iterator end() const;
+
+      class cursor
+      {
+      public:
+         cursor(const sequence& owner);
+         void start();
+         void advance();
+         void seek(size_type index);
+         bool is_item() const;
+         value_type current() const;
+         size_type index() const;
+      private:
+         const sequence* seq;
+         size_type current_index;
+      };
+      friend class const_iterator;
+      friend class cursor;
    private:
       value_type* data;
       size_type used;
       size_type current_index;
       size_type capacity;
+      memory_resource* resource;
+      value_type* make_array(size_type n);
+      void free_array(value_type* items, size_type n);
+      void open_gap(size_type index, size_type count);
    };
+
+   sequence::const_iterator operator+(sequence::const_iterator::difference_type n,
+                                      const sequence::const_iterator& it);
 }
 
 #endif
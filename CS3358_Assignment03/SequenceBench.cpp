@@ -0,0 +1,696 @@
+// FILE: SequenceBench.cpp
+// A non-interactive benchmark program comparing the sequence classes
+// on edit-heavy traces.
+//
+// USAGE: ./a3bench [n [edits [bulk [largest]]]]
+//        where n is the # of items each trace starts with (default
+//        20000), edits is the # of edits made by each trace (default
+//        20000), bulk is the # of items loaded by the bulk load
+//        (default 10000000) and largest is the largest size used by
+//        the positional operations (default 1000000; 100000000 works
+//        but needs about 6 GB, mostly for the treap's nodes).
+//
+// TRACES (each starts from a sequence of n items 0, 1, 2, ...)
+//   cursor edits:  starting in the middle, a mix of attach (60%),
+//                  insert (20%), remove_current (10%) and advance
+//                  (10%) at the cursor, as in an editor
+//   front inserts: insert at the front (the cursor stays there)
+//   filter sweep:  one pass from the front that removes every 3rd item
+//                  and attaches a new item after every 5th
+//   random edits:  insert (50%), attach (25%) or remove_current (25%)
+//                  at a random place, moved to with seek where the
+//                  class has it (else with start and advance)
+// Each trace is run on every sequence class and the items left are
+// checked against those of sequence; the time taken and the speed-up
+// over sequence are reported.
+//
+// BULK LOAD: bulk items are loaded into an empty sequence with attach,
+// one at a time, and with one attach_range; then a block of n / 20
+// items is put in the middle of a sequence of n items with insert and
+// with insert_range. The time taken and the # of allocations made are
+// reported.
+//
+// SHIFTING: 200 items are inserted at, then removed from, the front of
+// a sequence of bulk items; every edit shifts all the items, so the
+// rate at which the bytes are moved (in GB/s) is reported.
+//
+// POSITIONAL OPERATIONS: for sizes 1000, 10000, ... up to largest, a
+// mix of inserts, removes and reads (a third each) at random indexes,
+// each reached with seek (or, for sequence, start and advance), is run
+// on sequence, chunked_sequence and treap_sequence; the average time
+// per operation is reported. (sequence runs fewer operations at the
+// larger sizes, where each one takes O(n) time.)
+//
+// REDUCTIONS: the sum of a sequence of bulk items is taken with a
+// start/is_item/current/advance loop (over a cursor), then each reduction (sum with
+// each summation method, min, max, mean, variance and dot) is run on
+// the same items; the time taken, the rate at which the items are read
+// (in GB/s) and the speed-up over the loop are reported.
+//
+// ARENA: 10000 "requests" are served, each making 32 short-lived
+// sequences (of 64 items attached one at a time to a sequence of
+// capacity 4, then a copy with its first item removed) and adding them
+// up. The requests are served with the sequences' memory from
+// new_delete_resource(), from a monotonic_arena per request (given its
+// blocks by operator new) and from a monotonic_arena per request over a
+// buffer on the stack; the time per request and the # of allocations
+// made per request are reported.
+
+#include <iostream>    // provides cout
+#include <iomanip>     // provides setw
+#include <cstdlib>     // provides atoi, EXIT_SUCCESS
+#include <ctime>       // provides clock
+#include <new>         // provides bad_alloc
+#include "Sequence.h"
+#include "MemoryResource.h"
+#include "GapSequence.h"
+#include "ChunkedSequence.h"
+#include "TreapSequence.h"
+using namespace std;
+using namespace CS3358_FA2017;
+
+// Every dynamic allocation made by the program is counted (the default
+// operator new[] calls operator new).
+long allocations = 0;
+
+void* operator new(size_t size) throw (bad_alloc)
+{
+   ++allocations;
+   void* p = malloc(size ? size : 1);
+   if (p == 0)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) throw ()
+{
+   free(p);
+}
+
+// PROTOTYPES for functions used by this benchmark program:
+
+template <class Seq>
+void cursor_edits(Seq& s, size_t edits);
+template <class Seq>
+void front_inserts(Seq& s, size_t edits);
+template <class Seq>
+void filter_sweep(Seq& s, size_t edits);
+template <class Seq>
+void random_edits(Seq& s, size_t edits);
+// Pre:  (none)
+// Post: The trace (see TRACES above) has been run on s.
+
+template <class Seq>
+void move_to(Seq& s, size_t index);
+void move_to(chunked_sequence& s, size_t index);
+void move_to(treap_sequence& s, size_t index);
+// Pre:  index <= s.size()
+// Post: Item index of s is its current item (there is no current
+//       item if index == s.size()).
+
+template <class Seq>
+double run_trace(void (*trace)(Seq&, size_t), size_t n, size_t edits,
+                 double& checksum);
+// Pre:  (none)
+// Post: trace has been run on a Seq of n items and the CPU time (in
+//       seconds) it took is returned; checksum is a weighted sum of
+//       the items left (equal checksums mean, in practice, equal
+//       sequences).
+
+template <class Seq>
+void bench_trace(const char name[], void (*trace)(Seq&, size_t),
+                 size_t n, size_t edits, double baseSecs,
+                 double baseChecksum);
+// Pre:  baseSecs and baseChecksum are from run_trace for sequence.
+// Post: A line giving the time for trace on Seq and its speed-up over
+//       sequence has been written to cout (and a note if the items
+//       left are not those left in sequence).
+
+void bench_bulk(size_t n, size_t bulk);
+void bench_shift(size_t bulk);
+void bench_positional(size_t largest);
+void bench_reductions(size_t bulk);
+void bench_arena();
+// Pre:  (none)
+// Post: The bulk load (shifting, positional operations, reductions,
+//       arena; see above) has been run and its results written to cout.
+
+double serve_request(memory_resource* resource);
+// Pre:  resource is not null.
+// Post: One request (see ARENA above) has been served with its
+//       sequences' memory from resource, and the sum of its items
+//       returned.
+
+double loop_sum(const sequence& s, const sequence& other);
+double plain_sum(const sequence& s, const sequence& other);
+double kahan_sum(const sequence& s, const sequence& other);
+double pairwise_sum(const sequence& s, const sequence& other);
+double min_item(const sequence& s, const sequence& other);
+double max_item(const sequence& s, const sequence& other);
+double mean(const sequence& s, const sequence& other);
+double variance(const sequence& s, const sequence& other);
+double dot(const sequence& s, const sequence& other);
+// Pre:  s is not empty and other.size() == s.size()
+// Post: The reduction (see REDUCTIONS above) of s (and other, for dot)
+//       is returned; loop_sum adds up the items with a cursor.
+
+template <class Seq>
+void fill(Seq& s, size_t n);
+void fill(sequence& s, size_t n);
+void fill(treap_sequence& s, size_t n);
+// Pre:  s is empty.
+// Post: The items 0, 1, ..., n - 1 have been attached to s (with
+//       attach_range, a block at a time, where the class has it).
+
+template <class Seq>
+double positional_ops(Seq& s, size_t ops, double& sink);
+// Pre:  (none)
+// Post: ops positional operations (see above) have been run on s and
+//       the time they took (in seconds) returned; the items read have
+//       been added to sink.
+
+int main(int argc, char* argv[])
+{
+   size_t n = 20000, edits = 20000, bulk = 10000000;
+   if (argc > 1)
+      n = size_t(atoi(argv[1]));
+   if (argc > 2)
+      edits = size_t(atoi(argv[2]));
+   if (argc > 3)
+      bulk = size_t(atoi(argv[3]));
+   size_t largest = 1000000;
+   if (argc > 4)
+      largest = size_t(atol(argv[4]));
+
+   const int TRACES = 4;
+   const char* NAMES[TRACES] = { "cursor edits", "front inserts",
+                                 "filter sweep", "random edits" };
+   void (*plain[TRACES])(sequence&, size_t) =
+      { cursor_edits<sequence>, front_inserts<sequence>,
+        filter_sweep<sequence>, random_edits<sequence> };
+   void (*gap[TRACES])(gap_sequence&, size_t) =
+      { cursor_edits<gap_sequence>, front_inserts<gap_sequence>,
+        filter_sweep<gap_sequence>, random_edits<gap_sequence> };
+   void (*chunked[TRACES])(chunked_sequence&, size_t) =
+      { cursor_edits<chunked_sequence>, front_inserts<chunked_sequence>,
+        filter_sweep<chunked_sequence>, random_edits<chunked_sequence> };
+   void (*treap[TRACES])(treap_sequence&, size_t) =
+      { cursor_edits<treap_sequence>, front_inserts<treap_sequence>,
+        filter_sweep<treap_sequence>, random_edits<treap_sequence> };
+
+   for (int t = 0; t < TRACES; ++t)
+   {
+      cout << NAMES[t] << " (" << n << " items, " << edits << " edits):"
+           << endl;
+      double checksum;
+      double secs = run_trace(plain[t], n, edits, checksum);
+      bench_trace("sequence", plain[t], n, edits, secs, checksum);
+      bench_trace("gap_sequence", gap[t], n, edits, secs, checksum);
+      bench_trace("chunked_sequence", chunked[t], n, edits, secs, checksum);
+      bench_trace("treap_sequence", treap[t], n, edits, secs, checksum);
+   }
+   bench_bulk(n, bulk);
+   bench_shift(bulk);
+   bench_positional(largest);
+   bench_reductions(bulk);
+   bench_arena();
+   return EXIT_SUCCESS;
+}
+
+template <class Seq>
+void cursor_edits(Seq& s, size_t edits)
+{
+   s.start();
+   for (size_t i = 0; i < s.size() / 2; ++i)
+      s.advance();
+
+   unsigned seed = 2017u;
+   for (size_t e = 0; e < edits; ++e)
+   {
+      seed = seed * 1103515245u + 12345u;
+      unsigned r = (seed >> 8) % 10;
+      if (!s.is_item())
+         s.start();
+      if (r < 6)
+         s.attach(-double(e));
+      else if (r < 8)
+         s.insert(-double(e));
+      else if (r < 9)
+         s.remove_current();
+      else
+         s.advance();
+   }
+}
+
+template <class Seq>
+void front_inserts(Seq& s, size_t edits)
+{
+   s.start();
+   for (size_t e = 0; e < edits; ++e)
+      s.insert(-double(e));
+}
+
+template <class Seq>
+void filter_sweep(Seq& s, size_t edits)
+{
+   size_t i = 0, made = 0;
+   s.start();
+   while (s.is_item() && made < edits)
+   {
+      ++i;
+      if (i % 3 == 0)
+      {
+         s.remove_current();
+         ++made;
+         continue;
+      }
+      if (i % 5 == 0)
+      {
+         s.attach(-double(i));
+         ++made;
+      }
+      s.advance();
+   }
+}
+
+template <class Seq>
+void random_edits(Seq& s, size_t edits)
+{
+   unsigned seed = 3358u;
+   for (size_t e = 0; e < edits; ++e)
+   {
+      seed = seed * 1103515245u + 12345u;
+      size_t index = size_t(seed >> 4) % (s.size() + 1);
+      seed = seed * 1103515245u + 12345u;
+      unsigned r = (seed >> 8) % 4;
+      move_to(s, index);
+      if (r < 2)
+         s.insert(-double(e));
+      else if (r < 3)
+         s.attach(-double(e));
+      else
+         s.remove_current();
+   }
+}
+
+template <class Seq>
+void move_to(Seq& s, size_t index)
+{
+   s.start();
+   for (size_t i = 0; i < index; ++i)
+      s.advance();
+}
+
+void move_to(chunked_sequence& s, size_t index)
+{
+   s.seek(index);
+}
+
+void move_to(treap_sequence& s, size_t index)
+{
+   s.seek(index);
+}
+
+template <class Seq>
+double run_trace(void (*trace)(Seq&, size_t), size_t n, size_t edits,
+                 double& checksum)
+{
+   Seq s;
+   for (size_t i = 0; i < n; ++i)
+      s.attach(double(i));
+
+   clock_t start = clock();
+   trace(s, edits);
+   double secs = double(clock() - start) / CLOCKS_PER_SEC;
+
+   checksum = 0;
+   double weight = 1;
+   for (s.start(); s.is_item(); s.advance())
+   {
+      checksum += weight * s.current();
+      weight = weight * 1.0001;
+   }
+   return secs;
+}
+
+template <class Seq>
+void bench_trace(const char name[], void (*trace)(Seq&, size_t),
+                 size_t n, size_t edits, double baseSecs,
+                 double baseChecksum)
+{
+   double checksum;
+   double secs = run_trace(trace, n, edits, checksum);
+   cout << "   " << left << setw(18) << name << right << fixed
+        << setprecision(3) << setw(10) << secs * 1e3 << " ms";
+   if (secs > 0)
+      cout << setw(10) << setprecision(1) << baseSecs / secs << "x";
+   if (checksum != baseChecksum)
+      cout << "   *** items differ from sequence";
+   cout << endl;
+}
+
+void bench_bulk(size_t n, size_t bulk)
+{
+   double* values = new double[bulk > n ? bulk : n];
+   for (size_t i = 0; i < bulk || i < n; ++i)
+      values[i] = double(i);
+
+   cout << "bulk load of " << bulk << " items:" << endl;
+   for (int way = 0; way < 2; ++way)
+   {
+      sequence s;
+      long before = allocations;
+      clock_t start = clock();
+      if (way == 0)
+      {
+         for (size_t i = 0; i < bulk; ++i)
+            s.attach(values[i]);
+      }
+      else
+         s.attach_range(values, values + bulk);
+      double secs = double(clock() - start) / CLOCKS_PER_SEC;
+      cout << "   " << left << setw(18) << (way == 0 ? "attach" : "attach_range")
+           << right << fixed << setprecision(3) << setw(10) << secs * 1e3
+           << " ms" << setw(8) << allocations - before << " allocations"
+           << endl;
+   }
+
+   size_t block = n / 20;
+   cout << "block of " << block << " items into the middle of " << n
+        << " items:" << endl;
+   for (int way = 0; way < 2; ++way)
+   {
+      sequence s;
+      s.attach_range(values, values + n);
+      s.start();
+      for (size_t i = 0; i < n / 2; ++i)
+         s.advance();
+
+      long before = allocations;
+      clock_t start = clock();
+      if (way == 0)
+      {
+         // inserted last to first, each in front of the one before
+         for (size_t i = block; i > 0; --i)
+            s.insert(values[i - 1]);
+      }
+      else
+         s.insert_range(values, values + block);
+      double secs = double(clock() - start) / CLOCKS_PER_SEC;
+      cout << "   " << left << setw(18) << (way == 0 ? "insert" : "insert_range")
+           << right << fixed << setprecision(3) << setw(10) << secs * 1e3
+           << " ms" << setw(8) << allocations - before << " allocations"
+           << endl;
+   }
+   delete [] values;
+}
+
+void bench_shift(size_t bulk)
+{
+   const size_t EDITS = 200;
+   double* values = new double[bulk];
+   for (size_t i = 0; i < bulk; ++i)
+      values[i] = double(i);
+   sequence s;
+   s.attach_range(values, values + bulk);
+   delete [] values;
+
+   cout << "shifting " << bulk << " items:" << endl;
+   clock_t start = clock();
+   s.start();
+   for (size_t e = 0; e < EDITS; ++e)
+      s.insert(-double(e));
+   double insertSecs = double(clock() - start) / CLOCKS_PER_SEC;
+   start = clock();
+   s.start();
+   for (size_t e = 0; e < EDITS; ++e)
+      s.remove_current();
+   double removeSecs = double(clock() - start) / CLOCKS_PER_SEC;
+
+   double bytes = double(EDITS) * bulk * sizeof(double);
+   cout << "   " << left << setw(18) << "insert at front" << right << fixed
+        << setprecision(3) << setw(10) << insertSecs * 1e3 << " ms";
+   if (insertSecs > 0)
+      cout << setw(10) << setprecision(2) << bytes / insertSecs / 1e9 << " GB/s";
+   cout << endl << "   " << left << setw(18) << "remove at front" << right
+        << setprecision(3) << setw(10) << removeSecs * 1e3 << " ms";
+   if (removeSecs > 0)
+      cout << setw(10) << setprecision(2) << bytes / removeSecs / 1e9 << " GB/s";
+   cout << endl;
+}
+
+template <class Seq>
+void fill(Seq& s, size_t n)
+{
+   for (size_t i = 0; i < n; ++i)
+      s.attach(double(i));
+}
+
+void fill(sequence& s, size_t n)
+{
+   const size_t BLOCK = 65536;
+   double block[BLOCK];
+   s.resize(n);
+   for (size_t i = 0; i < n; i += BLOCK)
+   {
+      size_t k = (n - i < BLOCK) ? n - i : BLOCK;
+      for (size_t j = 0; j < k; ++j)
+         block[j] = double(i + j);
+      s.attach_range(block, block + k);
+   }
+}
+
+void fill(treap_sequence& s, size_t n)
+{
+   const size_t BLOCK = 65536;
+   double block[BLOCK];
+   for (size_t i = 0; i < n; i += BLOCK)
+   {
+      size_t k = (n - i < BLOCK) ? n - i : BLOCK;
+      for (size_t j = 0; j < k; ++j)
+         block[j] = double(i + j);
+      s.attach_range(block, block + k);
+   }
+}
+
+template <class Seq>
+double positional_ops(Seq& s, size_t ops, double& sink)
+{
+   unsigned seed = 47u;
+   clock_t start = clock();
+   for (size_t op = 0; op < ops; ++op)
+   {
+      seed = seed * 1103515245u + 12345u;
+      size_t index = size_t(seed >> 4);
+      seed = seed * 1103515245u + 12345u;
+      unsigned r = (seed >> 8) % 3;
+      if (r == 0 || s.size() == 0)
+      {
+         move_to(s, index % (s.size() + 1));
+         s.insert(-double(op));
+      }
+      else
+      {
+         move_to(s, index % s.size());
+         if (r == 1)
+            s.remove_current();
+         else
+            sink += s.current();
+      }
+   }
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void bench_positional(size_t largest)
+{
+   const size_t OPS = 20000;
+   double sink = 0;
+
+   cout << "positional operations (us/op):" << endl;
+   cout << "   " << left << setw(12) << "items" << right << setw(12)
+        << "sequence" << setw(18) << "chunked_sequence" << setw(16)
+        << "treap_sequence" << endl;
+   for (size_t n = 1000; n <= largest; n *= 10)
+   {
+      // sequence's operations take O(n) each: keep its total work down
+      size_t arrayOps = 20000000 / n;
+      if (arrayOps > OPS)
+         arrayOps = OPS;
+      if (arrayOps < 10)
+         arrayOps = 10;
+
+      double arraySecs, chunkedSecs, treapSecs;
+      {
+         sequence s;
+         fill(s, n);
+         arraySecs = positional_ops(s, arrayOps, sink);
+      }
+      {
+         chunked_sequence s;
+         fill(s, n);
+         chunkedSecs = positional_ops(s, OPS, sink);
+      }
+      {
+         treap_sequence s;
+         fill(s, n);
+         treapSecs = positional_ops(s, OPS, sink);
+      }
+      cout << "   " << left << setw(12) << n << right << fixed
+           << setprecision(3) << setw(12) << arraySecs * 1e6 / arrayOps
+           << setw(18) << chunkedSecs * 1e6 / OPS
+           << setw(16) << treapSecs * 1e6 / OPS << endl;
+   }
+   if (sink == 0.5)
+      cout << endl;     // (keeps the reads from being optimized away)
+}
+
+void bench_reductions(size_t bulk)
+{
+   const int REDUCTIONS = 9, REPEATS = 5;
+   const char* NAMES[REDUCTIONS] = { "cursor loop sum", "sum",
+                                     "sum (Kahan)", "sum (pairwise)",
+                                     "min", "max", "mean", "variance",
+                                     "dot" };
+   double (*reduce[REDUCTIONS])(const sequence&, const sequence&) =
+      { loop_sum, plain_sum, kahan_sum, pairwise_sum, min_item, max_item,
+        mean, variance, dot };
+   // passes over the items (variance reads them twice, dot reads both
+   // sequences)
+   const int PASSES[REDUCTIONS] = { 1, 1, 1, 1, 1, 1, 1, 2, 2 };
+
+   if (bulk == 0)
+      return;
+   double* values = new double[bulk];
+   for (size_t i = 0; i < bulk; ++i)
+      values[i] = double(i % 1000) * 0.001;
+   sequence s(bulk), other(bulk);
+   s.attach_range(values, values + bulk);
+   other.attach_range(values, values + bulk);
+   delete [] values;
+
+   cout << "reductions over " << bulk << " items:" << endl;
+   double loopSecs = 0.0, sink = 0.0;
+   for (int r = 0; r < REDUCTIONS; ++r)
+   {
+      clock_t start = clock();
+      for (int k = 0; k < REPEATS; ++k)
+         sink += reduce[r](s, other);
+      double secs = double(clock() - start) / CLOCKS_PER_SEC / REPEATS;
+      if (r == 0)
+         loopSecs = secs;
+      double bytes = double(PASSES[r]) * bulk * sizeof(double);
+      cout << "   " << left << setw(18) << NAMES[r] << right << fixed
+           << setprecision(3) << setw(10) << secs * 1e3 << " ms";
+      if (secs > 0)
+         cout << setw(10) << setprecision(2) << bytes / secs / 1e9 << " GB/s"
+              << setw(10) << setprecision(1) << loopSecs / secs << "x";
+      cout << endl;
+   }
+   if (sink == 0.5)
+      cout << "(sink " << sink << ")" << endl;
+}
+
+double loop_sum(const sequence& s, const sequence& other)
+{
+   sequence::cursor walk(s);
+   double total = 0.0;
+   for (walk.start(); walk.is_item(); walk.advance())
+      total += walk.current();
+   return total;
+}
+
+double plain_sum(const sequence& s, const sequence& other)
+{
+   return s.sum();
+}
+
+double kahan_sum(const sequence& s, const sequence& other)
+{
+   return s.sum(sequence::KAHAN_SUM);
+}
+
+double pairwise_sum(const sequence& s, const sequence& other)
+{
+   return s.sum(sequence::PAIRWISE_SUM);
+}
+
+double min_item(const sequence& s, const sequence& other)
+{
+   return s.min();
+}
+
+double max_item(const sequence& s, const sequence& other)
+{
+   return s.max();
+}
+
+double mean(const sequence& s, const sequence& other)
+{
+   return s.mean();
+}
+
+double variance(const sequence& s, const sequence& other)
+{
+   return s.variance();
+}
+
+double dot(const sequence& s, const sequence& other)
+{
+   return s.dot(other);
+}
+
+void bench_arena()
+{
+   const int REQUESTS = 10000, WAYS = 3;
+   const size_t BUFFER_SIZE = 131072;
+   const char* NAMES[WAYS] = { "new/delete", "arena", "arena on stack" };
+
+   cout << "arena: " << REQUESTS << " requests:" << endl;
+   double sink = 0.0;
+   for (int way = 0; way < WAYS; ++way)
+   {
+      long before = allocations;
+      clock_t start = clock();
+      for (int r = 0; r < REQUESTS; ++r)
+      {
+         if (way == 0)
+            sink += serve_request(new_delete_resource());
+         else if (way == 1)
+         {
+            monotonic_arena arena;
+            sink += serve_request(&arena);
+         }
+         else
+         {
+            char buffer[BUFFER_SIZE];
+            monotonic_arena arena(buffer, BUFFER_SIZE);
+            sink += serve_request(&arena);
+         }
+      }
+      double secs = double(clock() - start) / CLOCKS_PER_SEC;
+      cout << "   " << left << setw(18) << NAMES[way] << right << fixed
+           << setprecision(3) << setw(10) << secs * 1e6 / REQUESTS
+           << " us/request" << setw(10) << setprecision(1)
+           << double(allocations - before) / REQUESTS
+           << " allocations/request" << endl;
+   }
+   if (sink == 0.5)
+      cout << "(sink " << sink << ")" << endl;
+}
+
+double serve_request(memory_resource* resource)
+{
+   const int SEQUENCES = 32, ITEMS = 64;
+   double total = 0.0;
+   for (int k = 0; k < SEQUENCES; ++k)
+   {
+      sequence s(4, resource);
+      for (int i = 0; i < ITEMS; ++i)
+         s.attach(double(k + i));
+      sequence trimmed(s, resource);
+      trimmed.start();
+      trimmed.remove_current();
+      total += s.sum() + trimmed.sum();
+   }
+   return total;
+}
@@ -0,0 +1,373 @@
+// FILE: TreapSequence.cpp
+// CLASS IMPLEMENTED: treap_sequence (see TreapSequence.h for
+//                    documentation)
+// INVARIANT for the treap_sequence ADT:
+//   1. The items of the sequence are the values of the nodes of the
+//      binary tree pointed to by the member variable root (null for an
+//      empty sequence), in in-order (left subtree, node, right subtree)
+//      order.
+//   2. Each node's count is the number of nodes in the subtree rooted
+//      at it, so count(root) is the number of items in the sequence.
+//   3. No node's priority is greater than its parent's.
+//   4. The index of the current item is in the member variable
+//      current_index; if there is no valid current item, current_index
+//      is the same number as the number of items (see Sequence.cpp for
+//      why).
+//   5. The member variable seed is the state of the (xorshift) random
+//      number generator the priorities come from.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   unsigned next_priority()
+//    Pre:  none
+//    Post: The next pseudo-random priority has been returned.
+//   node* build(const value_type* first, const value_type* last)
+//    Pre:  first <= last
+//    Post: A treap of new nodes for copies of first[0] through
+//      last[-1], in that order, has been built in O(k) time and its
+//      root (null if first == last) returned.
+//   void join_at(size_type index, node* middle)
+//    Pre:  index <= size() and middle is a treap not part of this one.
+//    Post: The items of middle have been joined in so that the first of
+//      them is item index; current_index is unchanged.
+//   static size_type count(const node* t)
+//    Pre:  none
+//    Post: The number of nodes in tree t (0 if t is null) is returned.
+//   static size_type fix_counts(node* t)
+//    Pre:  none
+//    Post: The count of every node of tree t has been set (from the
+//      bottom up) and the number of nodes in t returned.
+//   static void split(node* t, size_type k, node*& left, node*& right)
+//    Pre:  k <= count(t)
+//    Post: Tree t has been split into left, the treap of its first k
+//      items, and right, the treap of the rest; no node is made or
+//      freed.
+//   static node* merge(node* left, node* right)
+//    Pre:  left and right are treaps (not sharing nodes).
+//    Post: The root of a treap of the items of left followed by those of
+//      right is returned; no node is made or freed.
+//   static node* copy(const node* t)
+//   static void destroy(node* t)
+//    Pre:  none
+//    Post: A new tree with the same shape, values and priorities as t
+//      has been returned (destroy: every node of t has been freed).
+
+#include <cassert>
+#include <vector>
+#include "TreapSequence.h"
+using namespace std;
+
+namespace CS3358_FA2017
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   treap_sequence::treap_sequence(size_type initial_capacity)
+      : root(0), current_index(0), seed(2463534242u) { }
+
+   treap_sequence::treap_sequence(const treap_sequence& source)
+      : root(copy(source.root)), current_index(source.current_index),
+        seed(source.seed ^ 0x9e3779b9u) { }
+
+   treap_sequence::~treap_sequence()
+   {
+       destroy(root);
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void treap_sequence::resize(size_type new_capacity) { }
+
+   void treap_sequence::start()
+   {
+       current_index = 0;
+   }
+
+   void treap_sequence::advance()
+   {
+       if (is_item())
+       {
+           current_index = current_index + 1;
+       }
+   }
+
+   void treap_sequence::insert(const value_type& entry)
+   {
+       insert_at(is_item() ? current_index : 0, entry);
+   }
+
+   void treap_sequence::attach(const value_type& entry)
+   {
+       insert_at(is_item() ? current_index + 1 : size(), entry);
+   }
+
+   void treap_sequence::remove_current()
+   {
+       if (is_item())
+       {
+           erase_at(current_index);
+       }
+   }
+
+   void treap_sequence::insert_range(const value_type* first,
+                                     const value_type* last)
+   {
+       if (first == last)
+       {
+           return;
+       }
+       if (!is_item())
+       {
+           start();
+       }
+       join_at(current_index, build(first, last));
+   }
+
+   void treap_sequence::attach_range(const value_type* first,
+                                     const value_type* last)
+   {
+       if (first == last)
+       {
+           return;
+       }
+       size_type index = is_item() ? current_index + 1 : size();
+       join_at(index, build(first, last));
+       current_index = index + (last - first) - 1;
+   }
+
+   void treap_sequence::seek(size_type index)
+   {
+       assert(index <= size());
+       current_index = index;
+   }
+
+   void treap_sequence::insert_at(size_type index, const value_type& entry)
+   {
+       assert(index <= size());
+       node* single = new node;
+       single->value = entry;
+       single->priority = next_priority();
+       single->count = 1;
+       single->left = 0;
+       single->right = 0;
+       join_at(index, single);
+       current_index = index;
+   }
+
+   void treap_sequence::erase_at(size_type index)
+   {
+       assert(index < size());
+       node* left;
+       node* rest;
+       node* middle;
+       node* right;
+       split(root, index, left, rest);
+       split(rest, 1, middle, right);
+       delete middle;
+       root = merge(left, right);
+       current_index = index;
+   }
+
+   void treap_sequence::split(size_type index, treap_sequence& tail)
+   {
+       assert(index <= size() && &tail != this);
+       node* left;
+       node* right;
+       split(root, index, left, right);
+       root = left;
+       destroy(tail.root);
+       tail.root = right;
+       tail.current_index = 0;
+       if (current_index > index)
+       {
+           current_index = index;
+       }
+   }
+
+   void treap_sequence::concat(treap_sequence& other)
+   {
+       assert(&other != this);
+       bool had_item = is_item();
+       root = merge(root, other.root);
+       other.root = 0;
+       other.current_index = 0;
+       if (!had_item)
+       {
+           current_index = size();
+       }
+   }
+
+   treap_sequence& treap_sequence::operator=(const treap_sequence& source)
+   {
+      if (this != &source)
+      {
+          node* temp = copy(source.root);
+          destroy(root);
+          root = temp;
+          current_index = source.current_index;
+      }
+
+      return *this;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   treap_sequence::size_type treap_sequence::size() const
+   {
+       return count(root);
+   }
+
+   bool treap_sequence::is_item() const
+   {
+       return current_index < size();
+   }
+
+   treap_sequence::value_type treap_sequence::current() const
+   {
+       assert(is_item());
+       const node* cursor = root;
+       size_type index = current_index;
+       while (index != count(cursor->left))
+       {
+           if (index < count(cursor->left))
+           {
+               cursor = cursor->left;
+           }
+           else
+           {
+               index = index - count(cursor->left) - 1;
+               cursor = cursor->right;
+           }
+       }
+       return cursor->value;
+   }
+
+   // PRIVATE HELPERS
+   unsigned treap_sequence::next_priority()
+   {
+       seed ^= seed << 13;
+       seed ^= seed >> 17;
+       seed ^= seed << 5;
+       return seed;
+   }
+
+   treap_sequence::node* treap_sequence::build(const value_type* first,
+                                               const value_type* last)
+   {
+       // the right spine of the treap built so far: each new node goes
+       // at the bottom of it, taking the nodes of lower priority that
+       // it pops off as its left subtree
+       vector<node*> spine;
+       for ( ; first != last; ++first)
+       {
+           node* added = new node;
+           added->value = *first;
+           added->priority = next_priority();
+           added->right = 0;
+           node* popped = 0;
+           while (!spine.empty() && spine.back()->priority < added->priority)
+           {
+               popped = spine.back();
+               spine.pop_back();
+           }
+           added->left = popped;
+           if (!spine.empty())
+           {
+               spine.back()->right = added;
+           }
+           spine.push_back(added);
+       }
+       if (spine.empty())
+       {
+           return 0;
+       }
+       fix_counts(spine[0]);
+       return spine[0];
+   }
+
+   void treap_sequence::join_at(size_type index, node* middle)
+   {
+       node* left;
+       node* right;
+       split(root, index, left, right);
+       root = merge(merge(left, middle), right);
+   }
+
+   treap_sequence::size_type treap_sequence::count(const node* t)
+   {
+       return t ? t->count : 0;
+   }
+
+   treap_sequence::size_type treap_sequence::fix_counts(node* t)
+   {
+       if (t == 0)
+       {
+           return 0;
+       }
+       t->count = 1 + fix_counts(t->left) + fix_counts(t->right);
+       return t->count;
+   }
+
+   void treap_sequence::split(node* t, size_type k, node*& left, node*& right)
+   {
+       if (t == 0)
+       {
+           left = 0;
+           right = 0;
+           return;
+       }
+       if (count(t->left) < k)
+       {
+           // t and its left subtree go left; split its right subtree
+           split(t->right, k - count(t->left) - 1, t->right, right);
+           left = t;
+       }
+       else
+       {
+           split(t->left, k, left, t->left);
+           right = t;
+       }
+       t->count = 1 + count(t->left) + count(t->right);
+   }
+
+   treap_sequence::node* treap_sequence::merge(node* left, node* right)
+   {
+       if (left == 0)
+       {
+           return right;
+       }
+       if (right == 0)
+       {
+           return left;
+       }
+       if (left->priority > right->priority)
+       {
+           left->right = merge(left->right, right);
+           left->count = 1 + count(left->left) + count(left->right);
+           return left;
+       }
+       right->left = merge(left, right->left);
+       right->count = 1 + count(right->left) + count(right->right);
+       return right;
+   }
+
+   treap_sequence::node* treap_sequence::copy(const node* t)
+   {
+       if (t == 0)
+       {
+           return 0;
+       }
+       node* result = new node;
+       result->value = t->value;
+       result->priority = t->priority;
+       result->count = t->count;
+       result->left = copy(t->left);
+       result->right = copy(t->right);
+       return result;
+   }
+
+   void treap_sequence::destroy(node* t)
+   {
+       if (t != 0)
+       {
+           destroy(t->left);
+           destroy(t->right);
+           delete t;
+       }
+   }
+}
@@ -0,0 +1,150 @@
+// FILE: TreapSequence.h
+// CLASS PROVIDED: treap_sequence (part of the namespace CS3358_FA2017)
+//
+// A treap_sequence is a sequence (see Sequence.h) with the same public
+// interface and behavior, plus operations by position (index, counting
+// from 0 at the front), meant for long sequences that need both edits
+// and random access anywhere. The items are kept in an implicit treap:
+// a binary tree whose in-order walk gives the items in sequence order,
+// where each node also holds the number of nodes in its subtree (so
+// the item at any index can be found from the root) and a random
+// priority no greater than its parent's (which keeps the tree's height
+// O(log n) with high probability, whatever the order of the edits).
+// So every operation below takes O(log n) expected time, except the
+// range functions (O(log n + k) for k items), the copy constructor,
+// assignment and the destructor (O(n)).
+//
+// TYPEDEFS and MEMBER CONSTANTS for the treap_sequence class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//   static const size_type DEFAULT_CAPACITY = _____
+//    As for sequence.
+//
+// CONSTRUCTOR for the treap_sequence class:
+//   treap_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: The treap_sequence has been initialized as an empty
+//      sequence. (A treap_sequence has no capacity, as each item has a
+//      node of its own: initial_capacity is only there so that code
+//      written for sequence works unchanged.)
+//
+// MODIFICATION MEMBER FUNCTIONS for the treap_sequence class:
+//   void resize(size_type new_capacity)
+//    Pre:  none
+//    Post: none (as for the constructor's initial_capacity).
+//
+//   void start()
+//   void advance()
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//    Same as for sequence (see Sequence.h).
+//
+//   void insert_range(const value_type* first, const value_type* last)
+//   void attach_range(const value_type* first, const value_type* last)
+//    Same as for sequence (see Sequence.h); the k new items are built
+//    into a treap of their own in O(k) time and then joined in.
+//
+//   void seek(size_type index)
+//    Pre:  index <= size()
+//    Post: Item index is now the current item (there is no current item
+//      if index == size()).
+//
+//   void insert_at(size_type index, const value_type& entry)
+//    Pre:  index <= size()
+//    Post: A new copy of entry has been inserted in the sequence so that
+//      it is item index (after all the other items if index was size());
+//      the newly inserted item is now the current item.
+//
+//   void erase_at(size_type index)
+//    Pre:  index < size()
+//    Post: Item index has been removed from the sequence, and the item
+//      after it (if there is one) is now the current item; otherwise
+//      there is no current item.
+//
+//   void split(size_type index, treap_sequence& tail)
+//    Pre:  index <= size() and tail is not this treap_sequence.
+//    Post: The items from item index on have been moved, in order, into
+//      tail (replacing what tail held), whose first item (if any) is now
+//      its current item; this treap_sequence keeps items 0 through
+//      index - 1, with its current item unchanged if it is one of them
+//      (otherwise there is no current item).
+//
+//   void concat(treap_sequence& other)
+//    Pre:  other is not this treap_sequence.
+//    Post: The items of other have been moved, in order, to the end of
+//      this treap_sequence (other is now empty); the current item is
+//      unchanged (if there was none, there is still none).
+//
+// CONSTANT MEMBER FUNCTIONS for the treap_sequence class:
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    Same as for sequence (see Sequence.h); size and is_item take O(1)
+//    time.
+//
+// VALUE SEMANTICS for the treap_sequence class:
+//   Assignments and the copy constructor may be used with
+//   treap_sequence objects.
+
+#ifndef TREAP_SEQUENCE_H
+#define TREAP_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2017
+{
+   class treap_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      // CONSTRUCTORS and DESTRUCTOR
+      treap_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      treap_sequence(const treap_sequence& source);
+      ~treap_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void insert_range(const value_type* first, const value_type* last);
+      void attach_range(const value_type* first, const value_type* last);
+      void seek(size_type index);
+      void insert_at(size_type index, const value_type& entry);
+      void erase_at(size_type index);
+      void split(size_type index, treap_sequence& tail);
+      void concat(treap_sequence& other);
+      treap_sequence& operator=(const treap_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct node
+      {
+         value_type value;
+         unsigned priority;
+         size_type count;
+         node* left;
+         node* right;
+      };
+      node* root;
+      size_type current_index;
+      unsigned seed;
+      unsigned next_priority();
+      node* build(const value_type* first, const value_type* last);
+      void join_at(size_type index, node* middle);
+      static size_type count(const node* t);
+      static size_type fix_counts(node* t);
+      static void split(node* t, size_type k, node*& left, node*& right);
+      static node* merge(node* left, node* right);
+      static node* copy(const node* t);
+      static void destroy(node* t);
+   };
+}
+
+#endif
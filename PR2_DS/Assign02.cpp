@@ -1,10 +1,17 @@
 // FILE: Assign02.cpp
 //       An interactive test program for the IntSet data type.
+//
+// USAGE: ./a2              (interactive, with menu)
+//        ./a2 auto         (scripted, e.g. ./a2 auto < a2test.in)
+//        ./a2 batch [file] (batch command file, no echo; see
+//                           IntSetBatch.h for the format)
 
 #include "IntSet.h"
+#include "IntSetBatch.h"
 #include <iostream>
 #include <iomanip>
 #include <cstdlib>
+#include <cstring>
 using namespace std;
 
 // PROTOTYPES for functions used by this test program:
@@ -49,6 +56,9 @@ int main(int argc, char* argv[])
        givenValue;         // holder for a user supplied value
    char choice;            // command character entered by the user
 
+   if (argc > 1 && strcmp(argv[1], "batch") == 0)
+      return run_batch_file(argc > 2 ? argv[2] : 0, cout);
+
    cout << "3 IntSet objects (is1 is2 is3) have been created." << endl;
 
    do
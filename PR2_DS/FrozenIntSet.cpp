@@ -0,0 +1,566 @@
+// FILE: FrozenIntSet.cpp
+//       Implementation file for the FrozenIntSet class
+//       (See FrozenIntSet.h for documentation.)
+// INVARIANT for the FrozenIntSet class:
+// (1) The # of elements is stored in used, and the # of blocks,
+//     (used + BLOCK_SIZE - 1) / BLOCK_SIZE, in numBlocks.
+// (2) storage is null for an empty FrozenIntSet; otherwise it is one
+//     dynamic array holding, in this order, the first element of each
+//     block (firsts(), numBlocks ints), the offset of each block's
+//     varints in the varint bytes (offsets(), numBlocks ints) and the
+//     numBytes varint bytes (varints(), padded to a whole int).
+// (3) Block b holds elements b * BLOCK_SIZE through the smaller of
+//     (b + 1) * BLOCK_SIZE and used, minus 1, in ascending order:
+//     firsts()[b] is the first of them and each of the others is
+//     encoded, starting at varints() + offsets()[b], as one varint of
+//     its (unsigned) difference from the element before it. The
+//     varints of block b end where those of block b + 1 (or, for the
+//     last block, the varint bytes) begin.
+// Since the elements are distinct and in ascending order, each set has
+// exactly one encoding; equal FrozenIntSet's have identical storage.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   const int* firsts() const
+//   const int* offsets() const
+//   const unsigned char* varints() const
+//     Pre:  (none)
+//     Post: The parts of storage (see (2)) are returned.
+//   static const unsigned char* decode(const unsigned char* p,
+//                                      unsigned& delta)
+//     Pre:  p points to a varint.
+//     Post: The varint has been decoded into delta and a pointer to
+//           the byte after it is returned.
+//   template <class Keep>
+//   FrozenIntSet merge(const FrozenIntSet& other, Keep keep) const
+//     Pre:  keep(inThis, inOther) tells whether an element that is
+//           (or isn't) in the invoking FrozenIntSet and in other
+//           belongs in the result.
+//     Post: The FrozenIntSet of the elements of either operand that
+//           keep accepts is returned (built by one merge pass over
+//           both operands).
+//
+// Builder (a private helper class) encodes a FrozenIntSet from values
+// pushed in ascending order, growing its arrays as it goes; finish()
+// copies them into a FrozenIntSet's exact-size storage.
+
+#include "FrozenIntSet.h"
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <climits>
+using namespace std;
+
+class FrozenIntSet::Builder
+{
+public:
+   Builder() : count(0), last(0) { }
+
+   void push(int value)
+   {
+      if (count % BLOCK_SIZE == 0)
+      {
+         blockFirsts.push_back(value);
+         blockOffsets.push_back(int(bytes.size()));
+      }
+      else
+      {
+         unsigned delta = unsigned(value) - unsigned(last);
+         while (delta >= 0x80u)
+         {
+            bytes.push_back((unsigned char)((delta & 0x7fu) | 0x80u));
+            delta >>= 7;
+         }
+         bytes.push_back((unsigned char)delta);
+      }
+      last = value;
+      ++count;
+   }
+
+   FrozenIntSet finish() const
+   {
+      FrozenIntSet result;
+      if (count == 0)
+      {
+         return result;
+      }
+      result.used = count;
+      result.numBlocks = int(blockFirsts.size());
+      result.numBytes = int(bytes.size());
+      result.storage = new int[2 * result.numBlocks +
+                               (result.numBytes + 3) / 4];
+      copy(blockFirsts.begin(), blockFirsts.end(), result.storage);
+      copy(blockOffsets.begin(), blockOffsets.end(),
+           result.storage + result.numBlocks);
+      if (!bytes.empty())
+      {
+         memcpy(result.storage + 2 * result.numBlocks, &bytes[0],
+                bytes.size());
+      }
+      return result;
+   }
+
+private:
+   int count;
+   int last;
+   vector<int> blockFirsts;
+   vector<int> blockOffsets;
+   vector<unsigned char> bytes;
+};
+
+namespace
+{
+   void put_int(ostream& out, int value)
+   {
+      unsigned u = unsigned(value);
+      char buf[4] = { char(u & 0xff), char((u >> 8) & 0xff),
+                      char((u >> 16) & 0xff), char((u >> 24) & 0xff) };
+      out.write(buf, 4);
+   }
+
+   bool get_int(istream& in, int& value)
+   {
+      unsigned char buf[4];
+      if (!in.read(reinterpret_cast<char*>(buf), 4))
+         return false;
+      value = int(unsigned(buf[0]) | (unsigned(buf[1]) << 8) |
+                  (unsigned(buf[2]) << 16) | (unsigned(buf[3]) << 24));
+      return true;
+   }
+
+   const char MAGIC[4] = { 'F', 'I', 'S', '1' };
+}
+
+FrozenIntSet::FrozenIntSet() : storage(0), used(0), numBlocks(0), numBytes(0) { }
+
+FrozenIntSet::FrozenIntSet(const IntSet& src)
+    : storage(0), used(0), numBlocks(0), numBytes(0)
+{
+    Builder builder;
+    if (src.isSorted())
+    {
+        for (IntSet::const_iterator it = src.begin(); it != src.end(); ++it)
+        {
+            builder.push(*it);
+        }
+    }
+    else
+    {
+        vector<int> values(src.begin(), src.end());
+        sort(values.begin(), values.end());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            builder.push(values[i]);
+        }
+    }
+    *this = builder.finish();
+}
+
+FrozenIntSet::FrozenIntSet(const FrozenIntSet& src)
+    : storage(0), used(src.used), numBlocks(src.numBlocks), numBytes(src.numBytes)
+{
+    if (src.storage != 0)
+    {
+        int n = 2 * numBlocks + (numBytes + 3) / 4;
+        storage = new int[n];
+        copy(src.storage, src.storage + n, storage);
+    }
+}
+
+FrozenIntSet::FrozenIntSet(FrozenIntSet&& src) noexcept
+    : storage(src.storage), used(src.used), numBlocks(src.numBlocks), numBytes(src.numBytes)
+{
+    src.storage = 0;
+    src.used = src.numBlocks = src.numBytes = 0;
+}
+
+FrozenIntSet::~FrozenIntSet()
+{
+    delete [] storage;
+}
+
+FrozenIntSet& FrozenIntSet::operator=(const FrozenIntSet& rhs)
+{
+    if (this != &rhs)
+    {
+        FrozenIntSet temp(rhs);
+        *this = std::move(temp);
+    }
+    return *this;
+}
+
+FrozenIntSet& FrozenIntSet::operator=(FrozenIntSet&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        delete [] storage;
+        storage = rhs.storage;
+        used = rhs.used;
+        numBlocks = rhs.numBlocks;
+        numBytes = rhs.numBytes;
+        rhs.storage = 0;
+        rhs.used = rhs.numBlocks = rhs.numBytes = 0;
+    }
+    return *this;
+}
+
+const int* FrozenIntSet::firsts() const
+{
+    return storage;
+}
+
+const int* FrozenIntSet::offsets() const
+{
+    return storage + numBlocks;
+}
+
+const unsigned char* FrozenIntSet::varints() const
+{
+    return reinterpret_cast<const unsigned char*>(storage + 2 * numBlocks);
+}
+
+const unsigned char* FrozenIntSet::decode(const unsigned char* p,
+                                          unsigned& delta)
+{
+    delta = 0;
+    int shift = 0;
+    while (*p & 0x80u)
+    {
+        delta |= unsigned(*p & 0x7fu) << shift;
+        shift += 7;
+        ++p;
+    }
+    delta |= unsigned(*p) << shift;
+    return p + 1;
+}
+
+FrozenIntSet::const_iterator::const_iterator() : set(0), pos(0), next(0), value(0) { }
+
+FrozenIntSet::const_iterator::const_iterator(const FrozenIntSet* owner, int start)
+    : set(owner), pos(start), next(0), value(0)
+{
+    if (pos < set->used)
+    {
+        value = set->firsts()[0];
+        next = set->varints();
+    }
+}
+
+const int& FrozenIntSet::const_iterator::operator*() const
+{
+    return value;
+}
+
+const int* FrozenIntSet::const_iterator::operator->() const
+{
+    return &value;
+}
+
+FrozenIntSet::const_iterator& FrozenIntSet::const_iterator::operator++()
+{
+    pos++;
+    if (pos < set->used)
+    {
+        if (pos % BLOCK_SIZE == 0)
+        {
+            // the next block starts with its first element, in full
+            value = set->firsts()[pos / BLOCK_SIZE];
+            next = set->varints() + set->offsets()[pos / BLOCK_SIZE];
+        }
+        else
+        {
+            unsigned delta;
+            next = decode(next, delta);
+            value = int(unsigned(value) + delta);
+        }
+    }
+    return *this;
+}
+
+FrozenIntSet::const_iterator FrozenIntSet::const_iterator::operator++(int)
+{
+    const_iterator before = *this;
+    ++*this;
+    return before;
+}
+
+bool FrozenIntSet::const_iterator::operator==(const const_iterator& rhs) const
+{
+    return pos == rhs.pos && set == rhs.set;
+}
+
+bool FrozenIntSet::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return !(*this == rhs);
+}
+
+FrozenIntSet::const_iterator FrozenIntSet::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+FrozenIntSet::const_iterator FrozenIntSet::end() const
+{
+    return const_iterator(this, used);
+}
+
+int FrozenIntSet::size() const
+{
+    return used;
+}
+
+bool FrozenIntSet::isEmpty() const
+{
+    return used == 0;
+}
+
+bool FrozenIntSet::contains(int anInt) const
+{
+    if (used == 0)
+    {
+        return false;
+    }
+
+    // the last block whose first element is <= anInt
+    const int* f = firsts();
+    int b = int(upper_bound(f, f + numBlocks, anInt) - f) - 1;
+    if (b < 0)
+    {
+        return false;
+    }
+
+    int value = f[b];
+    int n = used - b * BLOCK_SIZE;   // # of elements in block b
+    if (n > BLOCK_SIZE)
+    {
+        n = BLOCK_SIZE;
+    }
+    const unsigned char* p = varints() + offsets()[b];
+    for (int k = 1; k < n && value < anInt; k++)
+    {
+        unsigned delta;
+        p = decode(p, delta);
+        value = int(unsigned(value) + delta);
+    }
+    return value == anInt;
+}
+
+bool FrozenIntSet::isSubsetOf(const FrozenIntSet& other) const
+{
+    if (used > other.used)
+    {
+        return false;
+    }
+
+    const_iterator b = other.begin(), bEnd = other.end();
+    for (const_iterator a = begin(), aEnd = end(); a != aEnd; ++a)
+    {
+        while (b != bEnd && *b < *a)
+        {
+            ++b;
+        }
+        if (b == bEnd || *b != *a)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Keep>
+FrozenIntSet FrozenIntSet::merge(const FrozenIntSet& other, Keep keep) const
+{
+    Builder builder;
+    const_iterator a = begin(), aEnd = end();
+    const_iterator b = other.begin(), bEnd = other.end();
+    while (a != aEnd && b != bEnd)
+    {
+        if (*a < *b)
+        {
+            if (keep(true, false))
+                builder.push(*a);
+            ++a;
+        }
+        else if (*b < *a)
+        {
+            if (keep(false, true))
+                builder.push(*b);
+            ++b;
+        }
+        else
+        {
+            if (keep(true, true))
+                builder.push(*a);
+            ++a;
+            ++b;
+        }
+    }
+    for (; a != aEnd && keep(true, false); ++a)
+    {
+        builder.push(*a);
+    }
+    for (; b != bEnd && keep(false, true); ++b)
+    {
+        builder.push(*b);
+    }
+    return builder.finish();
+}
+
+FrozenIntSet FrozenIntSet::unionWith(const FrozenIntSet& other) const
+{
+    return merge(other, [](bool, bool) { return true; });
+}
+
+FrozenIntSet FrozenIntSet::intersect(const FrozenIntSet& other) const
+{
+    return merge(other, [](bool inThis, bool inOther) { return inThis && inOther; });
+}
+
+FrozenIntSet FrozenIntSet::subtract(const FrozenIntSet& other) const
+{
+    return merge(other, [](bool inThis, bool inOther) { return inThis && !inOther; });
+}
+
+IntSet FrozenIntSet::thaw() const
+{
+    // added in ascending order, each add is a plain append
+    IntSet result(used);
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        result.add(*it);
+    }
+    return result;
+}
+
+void FrozenIntSet::DumpData(ostream& out) const
+{
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        if (it != begin())
+            out << "  ";
+        out << *it;
+    }
+}
+
+long FrozenIntSet::bytes() const
+{
+    long n = sizeof(FrozenIntSet);
+    if (storage != 0)
+    {
+        n += long(2 * numBlocks + (numBytes + 3) / 4) * long(sizeof(int));
+    }
+    return n;
+}
+
+bool FrozenIntSet::write(ostream& out) const
+{
+    out.write(MAGIC, 4);
+    put_int(out, used);
+    put_int(out, numBytes);
+    for (int b = 0; b < numBlocks; b++)
+    {
+        put_int(out, firsts()[b]);
+        put_int(out, offsets()[b]);
+    }
+    if (numBytes > 0)
+    {
+        out.write(reinterpret_cast<const char*>(varints()), numBytes);
+    }
+    return bool(out);
+}
+
+bool FrozenIntSet::read(istream& in)
+{
+    char magic[4];
+    int count, byteCount;
+    if (!in.read(magic, 4) || memcmp(magic, MAGIC, 4) != 0 ||
+        !get_int(in, count) || !get_int(in, byteCount) ||
+        count < 0 || byteCount < 0)
+    {
+        return false;
+    }
+    int blocks = count / BLOCK_SIZE + (count % BLOCK_SIZE != 0);
+    if ((long long)byteCount > 5LL * (count - blocks))
+    {
+        return false;   // more than the longest possible varints
+    }
+
+    FrozenIntSet temp;
+    if (count == 0)
+    {
+        *this = std::move(temp);
+        return true;
+    }
+    temp.used = count;
+    temp.numBlocks = blocks;
+    temp.numBytes = byteCount;
+    temp.storage = new int[2 * blocks + (byteCount + 3) / 4];
+    int* f = temp.storage;
+    int* o = temp.storage + blocks;
+    for (int b = 0; b < blocks; b++)
+    {
+        if (!get_int(in, f[b]) || !get_int(in, o[b]))
+        {
+            return false;
+        }
+    }
+    unsigned char* v = reinterpret_cast<unsigned char*>(temp.storage + 2 * blocks);
+    if (byteCount > 0 &&
+        !in.read(reinterpret_cast<char*>(v), byteCount))
+    {
+        return false;
+    }
+
+    // check every block: its varints lie exactly between its offset
+    // and the next one, and the elements are strictly ascending
+    long long last = (long long)INT_MIN - 1;
+    for (int b = 0; b < blocks; b++)
+    {
+        int end = (b + 1 < blocks) ? o[b + 1] : byteCount;
+        if (o[b] < 0 || o[b] > end || end > byteCount || f[b] <= last)
+        {
+            return false;
+        }
+        long long value = f[b];
+        int p = o[b];
+        int n = count - b * BLOCK_SIZE;
+        if (n > BLOCK_SIZE)
+        {
+            n = BLOCK_SIZE;
+        }
+        for (int k = 1; k < n; k++)
+        {
+            unsigned long long delta = 0;
+            int shift = 0;
+            do
+            {
+                if (p == end || shift > 28)
+                {
+                    return false;
+                }
+                delta |= (unsigned long long)(v[p] & 0x7fu) << shift;
+                shift += 7;
+            } while (v[p++] & 0x80u);
+            value += (long long)delta;
+            if (delta == 0 || value > INT_MAX)
+            {
+                return false;
+            }
+        }
+        if (p != end)
+        {
+            return false;
+        }
+        last = value;
+    }
+
+    *this = std::move(temp);
+    return true;
+}
+
+bool operator==(const FrozenIntSet& fs1, const FrozenIntSet& fs2)
+{
+    // same size and subset is enough
+    if (fs1.size() != fs2.size())
+        return false;
+    return fs1.isSubsetOf(fs2);
+}
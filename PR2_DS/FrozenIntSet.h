@@ -0,0 +1,193 @@
+// FILE: FrozenIntSet.h - header file for the FrozenIntSet class
+// CLASS PROVIDED: FrozenIntSet (a read-only, compressed set of int
+//                 values, for keeping many IntSet's in memory or on
+//                 disk once they stop changing)
+//
+// REPRESENTATION
+//   The elements are kept in ascending order, cut into blocks of
+//   BLOCK_SIZE elements. The first element of each block is kept as is
+//   in a skip table; the others are kept as the difference from the
+//   element before them, written as a varint (7 bits per byte, low
+//   bits first, the top bit of a byte set when more bytes follow), so
+//   an element within 127 of the one before it takes 1 byte, within
+//   16383 takes 2 bytes, and so on (never more than 5). Clustered sets
+//   (runs of nearby values) thus take a little over 1 byte per
+//   element, against 4 bytes per entry plus the slack capacity and
+//   hash index of an IntSet.
+//
+// CONSTANT
+//   static const int BLOCK_SIZE = 128
+//     The # of elements per block (the last block may have fewer).
+//
+// CONSTRUCTORS
+//   FrozenIntSet()
+//     Post: The invoking FrozenIntSet is an empty set.
+//   explicit FrozenIntSet(const IntSet& src)
+//     Pre:  (none)
+//     Post: The invoking FrozenIntSet has the elements of src.
+//     Note: Takes O(n) time for an IntSet in sorted form, otherwise
+//           O(n log n) (the elements are sorted first).
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   int size() const
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: The # of elements is returned (isEmpty: true is returned
+//           if there are none).
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: True is returned if anInt is an element of the invoking
+//           FrozenIntSet, otherwise false is returned.
+//     Note: The block that could hold anInt is found by binary search
+//           of the skip table and only that block is decoded, so this
+//           takes O(log(n / BLOCK_SIZE) + BLOCK_SIZE) time.
+//   bool isSubsetOf(const FrozenIntSet& other) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking
+//           FrozenIntSet are also elements of other, otherwise false.
+//   FrozenIntSet unionWith(const FrozenIntSet& other) const
+//   FrozenIntSet intersect(const FrozenIntSet& other) const
+//   FrozenIntSet subtract(const FrozenIntSet& other) const
+//     Pre:  (none)
+//     Post: The union (intersection, difference) of the invoking
+//           FrozenIntSet and other is returned.
+//     Note: isSubsetOf and the set operations stream through both
+//           operands (decoding a block at a time, merging in order
+//           and encoding the result as it is produced), so they take
+//           linear time and never hold the elements uncompressed.
+//   IntSet thaw() const
+//     Pre:  (none)
+//     Post: An IntSet with the elements of the invoking FrozenIntSet
+//           (added in ascending order, so it is in sorted form) is
+//           returned.
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: The elements (in ascending order) have been inserted into
+//           out with 2 spaces separating one item from another.
+//   long bytes() const
+//     Pre:  (none)
+//     Post: The # of bytes of memory taken by the invoking
+//           FrozenIntSet (the object and its dynamic array) is
+//           returned.
+//   bool write(std::ostream& out) const
+//     Pre:  out was opened in binary mode.
+//     Post: The invoking FrozenIntSet has been written to out (see
+//           FILE FORMAT) and true is returned if out is still good.
+//
+// MODIFICATION MEMBER FUNCTION
+//   bool read(std::istream& in)
+//     Pre:  in was opened in binary mode.
+//     Post: If in holds a FrozenIntSet (as written by write) it has
+//           been read into the invoking FrozenIntSet and true is
+//           returned; otherwise false is returned and the invoking
+//           FrozenIntSet is unchanged. The data is checked in full
+//           (sizes, block offsets, varints and ascending order), so
+//           a damaged file is rejected rather than read.
+//
+// ITERATORS
+//   class const_iterator
+//     A forward iterator (std::forward_iterator_tag) over the elements
+//     in ascending order, decoding as it goes; *it is a const int&
+//     that refers into the iterator itself (so it is valid until the
+//     iterator is changed or destroyed).
+//   const_iterator begin() const
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: The iterator to the smallest element (end() if there are
+//           none), and the past-the-end iterator, are returned.
+//     Note: With begin(), end() and contains(), a FrozenIntSet can be
+//           an operand of the lazy views of IntSetViews.h.
+//
+// NON-MEMBER FUNCTION
+//   bool operator==(const FrozenIntSet& fs1, const FrozenIntSet& fs2)
+//     Pre:  (none)
+//     Post: True is returned if fs1 and fs2 have the same elements,
+//           otherwise false is returned.
+//
+// FILE FORMAT (all ints as 4 bytes, least significant byte first)
+//   "FIS1", the # of elements, the # of bytes of varints, then for
+//   each block its first element and the offset of its varints, then
+//   the varints.
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may be used with FrozenIntSet
+//   objects, and FrozenIntSet's can be moved (a moved-from
+//   FrozenIntSet is empty).
+
+#ifndef FROZEN_INT_SET_H
+#define FROZEN_INT_SET_H
+
+#include "IntSet.h"
+#include <iostream>
+#include <iterator>   // provides std::forward_iterator_tag
+#include <cstddef>    // provides std::ptrdiff_t
+
+class FrozenIntSet
+{
+public:
+   static const int BLOCK_SIZE = 128;
+   FrozenIntSet();
+   explicit FrozenIntSet(const IntSet& src);
+   FrozenIntSet(const FrozenIntSet& src);
+   FrozenIntSet(FrozenIntSet&& src) noexcept;
+   ~FrozenIntSet();
+   FrozenIntSet& operator=(const FrozenIntSet& rhs);
+   FrozenIntSet& operator=(FrozenIntSet&& rhs) noexcept;
+
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef int value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const int* pointer;
+      typedef const int& reference;
+      const_iterator();
+      reference operator*() const;
+      pointer operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+   private:
+      friend class FrozenIntSet;
+      const FrozenIntSet* set;
+      int pos;                   // # of elements before this one
+      const unsigned char* next; // the varint of the element after it
+      int value;
+      const_iterator(const FrozenIntSet* owner, int start);
+   };
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   bool isSubsetOf(const FrozenIntSet& other) const;
+   FrozenIntSet unionWith(const FrozenIntSet& other) const;
+   FrozenIntSet intersect(const FrozenIntSet& other) const;
+   FrozenIntSet subtract(const FrozenIntSet& other) const;
+   IntSet thaw() const;
+   void DumpData(std::ostream& out) const;
+   long bytes() const;
+   bool write(std::ostream& out) const;
+   bool read(std::istream& in);
+
+private:
+   class Builder;             // (see FrozenIntSet.cpp)
+   int* storage;              // skip table, then varints
+   int  used;
+   int  numBlocks;
+   int  numBytes;
+   const int* firsts() const;
+   const int* offsets() const;
+   const unsigned char* varints() const;
+   static const unsigned char* decode(const unsigned char* p,
+                                      unsigned& delta);
+   template <class Keep>
+   FrozenIntSet merge(const FrozenIntSet& other, Keep keep) const;
+};
+
+bool operator==(const FrozenIntSet& fs1, const FrozenIntSet& fs2);
+
+#endif
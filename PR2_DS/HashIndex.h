@@ -0,0 +1,104 @@
+// FILE: HashIndex.h - header file for the hash index functions
+// FUNCTIONS PROVIDED: the open-addressed hash index shared by IntSet
+//                     and HashedStorage<T> (Set.h)
+//
+// A hash index is an array of (1 << bits) int slots over an array of
+// entries kept by its user: each slot is either 0 (empty) or p + 1 for
+// the entry at position p. An entry's slot is found by linear probing
+// from its home slot (Fibonacci hashing of the entry's hash), and a
+// slot is freed by backward-shift deletion, so no slot is ever a
+// "deleted" marker. The user keeps the index at most half full (see
+// hashIndexBits) and tells the functions what its entries are through
+// the function objects passed to them.
+//
+// FUNCTIONS
+//   int hashIndexBits(int n)
+//     Pre:  (none)
+//     Post: The # of bits (at least 3) of an index that holds n
+//           entries at most half full is returned.
+//   int hashHomeSlot(unsigned hash, int bits)
+//     Pre:  1 <= bits <= 31
+//     Post: The slot of an index of (1 << bits) slots where the search
+//           for a value with the given hash starts is returned.
+//   template <class Matches>
+//   int hashFindSlot(const int* index, int bits, unsigned hash,
+//                    Matches matches)
+//     Pre:  index has (1 << bits) slots, at least one of them empty;
+//           matches(p) returns true if the entry at position p is the
+//           value searched for (whose hash is hash).
+//     Post: The slot holding the value's entry is returned if it has
+//           one, otherwise the empty slot where its entry would go.
+//   template <class HashOf>
+//   void hashEraseSlot(int* index, int bits, int slot, HashOf hashOf)
+//     Pre:  index has (1 << bits) slots and slot is one that is not
+//           empty; hashOf(p) returns the hash of the entry at position
+//           p.
+//     Post: slot's entry has been taken out of the index, and the
+//           entries after it in its probe run have been moved back as
+//           far as their home slots allow (so every other entry can
+//           still be found).
+//   void hashClear(int* index, int bits)
+//     Pre:  index has (1 << bits) slots.
+//     Post: Every slot of index is empty.
+
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+inline int hashIndexBits(int n)
+{
+   int bits = 3;
+   while ((1 << bits) < 2 * n)
+   {
+      bits++;
+   }
+   return bits;
+}
+
+inline int hashHomeSlot(unsigned hash, int bits)
+{
+   // Fibonacci hashing: the top bits bits of the product
+   return int((hash * 2654435769u) >> (32 - bits));
+}
+
+template <class Matches>
+int hashFindSlot(const int* index, int bits, unsigned hash, Matches matches)
+{
+   int mask = (1 << bits) - 1;
+   int s = hashHomeSlot(hash, bits);
+   while (index[s] != 0 && !matches(index[s] - 1))
+   {
+      s = (s + 1) & mask;
+   }
+   return s;
+}
+
+template <class HashOf>
+void hashEraseSlot(int* index, int bits, int slot, HashOf hashOf)
+{
+   // pull later entries of the probe run into the hole unless that
+   // would put them before their home slot
+   int mask = (1 << bits) - 1;
+   int hole = slot;
+   int s = (hole + 1) & mask;
+   while (index[s] != 0)
+   {
+      int home = hashHomeSlot(hashOf(index[s] - 1), bits);
+      if (((s - home) & mask) >= ((s - hole) & mask))
+      {
+         index[hole] = index[s];
+         hole = s;
+      }
+      s = (s + 1) & mask;
+   }
+   index[hole] = 0;
+}
+
+inline void hashClear(int* index, int bits)
+{
+   for (int s = 0; s < (1 << bits); s++)
+   {
+      index[s] = 0;
+   }
+}
+
+#endif
@@ -2,12 +2,17 @@
 //       Implementation file for the IntStore class
 //       (See IntSet.h for documentation.)
 // INVARIANT for the IntSet class:
-// (1) Distinct int values of the IntSet are stored in a 1-D,
-//     dynamic array whose size is stored in member variable
-//     capacity; the member variable data references the array.
+// (1) Distinct int values of the IntSet are stored as entries of a
+//     1-D array whose size is stored in member variable capacity;
+//     the member variable data references the array. The array is
+//     the inline array inlineData (capacity == INLINE_CAPACITY) for
+//     a small IntSet, otherwise it is a shared buffer (capacity >
+//     INLINE_CAPACITY; see (9)), so small IntSet's never allocate
+//     memory.
 // (2) The distinct int value with earliest membership is stored
-//     in data[0], the distinct int value with the 2nd-earliest
-//     membership is stored in data[1], and so on.
+//     in the earliest live entry of data, the distinct int value
+//     with the 2nd-earliest membership is stored in the next live
+//     entry, and so on.
 //     Note: No "prior membership" information is tracked; i.e.,
 //           if an int value that was previously a member (but its
 //           earlier membership ended due to removal) becomes a
@@ -18,28 +23,69 @@
 //           existing member (such as through the add operation)
 //           has no effect on the "membership timing" of that int
 //           value.
+// (3) The # of entries in use is stored in the member variable
+//     filled; entries data[0] through data[filled - 1] are in use
+//     and each of them is either live (holds a member) or removed
+//     (its member has since been removed). Removed entries are left
+//     in place (so that remove doesn't have to shift the entries
+//     after it) and are squeezed out by compact() once they
+//     outnumber the live ones.
 // (4) The # of distinct int values the IntSet currently contains
-//     is stored in the member variable used.
-// (5) Except when the IntSet is empty (used == 0), ALL elements
-//     of data from data[0] until data[used - 1] contain relevant
-//     distinct int values; i.e., all relevant distinct int values
-//     appear together (no "holes" among them) starting from the
-//     beginning of the data array.
+//     is stored in the member variable used (used <= filled; the
+//     IntSet has no removed entries when used == filled).
+// (5) A small IntSet has no index (index is null, indexBits is 0)
+//     and no removed entries (filled == used); its members are found
+//     by a linear scan of at most INLINE_CAPACITY entries, and remove
+//     closes the gap by shifting the (few) entries after it.
+//     Otherwise the member variable index references a hash table of
+//     (1 << indexBits) slots that is at most half full; it lives in
+//     the same dynamic array as the entries, right after them (i.e.,
+//     index == data + capacity and the array has capacity +
+//     (1 << indexBits) elements, with indexBits == bitsFor(capacity)),
+//     so each IntSet makes one allocation at a time. Each value
+//     held in a live entry data[p] has exactly one slot, holding
+//     p + 1, reached from the value's home slot by linear probing
+//     with no empty slot in between (see HashIndex.h, which has the
+//     index code IntSet shares with HashedStorage of Set.h); all
+//     other slots hold 0 (empty). Removed entries have no slot, which is how
+//     they are told apart from live ones: data[p] is live if and
+//     only if the slot found for data[p] holds p + 1.
 // (6) We DON'T care what is stored in any of the array elements
-//     from data[used] through data[capacity - 1].
-//     Note: This applies also when the IntSet is empry (used == 0)
-//           in which case we DON'T care what is stored in any of
-//           the data array elements.
+//     from data[filled] through data[capacity - 1].
 //     Note: A distinct int value in the IntSet can be any of the
 //           values an int can represent (from the most negative
 //           through 0 to the most positive), so there is no
 //           particular int value that can be used to indicate an
-//           irrelevant value. But there's no need for such an
-//           "indicator value" since all relevant distinct int
-//           values appear together starting from the beginning of
-//           the data array and used (if properly initialized and
-//           maintained) should tell which elements of the data
-//           array are actually relevant.
+//           irrelevant (or removed) value; the index is what tells
+//           which entries of the data array are actually relevant.
+// (7) The member variable sorted is true if the entries data[0]
+//     through data[filled - 1] are in ascending order (always the
+//     case when the IntSet is empty), otherwise sorted is false.
+//     Note: sorted is only ever set to true for an IntSet known to
+//           be in ascending order; it is not re-established when a
+//           remove happens to leave the remaining values in order.
+// (8) The member variable hashSum is the sum (wrapping around, as
+//     unsigned arithmetic does) of mix(x) over all members x. Being a
+//     sum, it doesn't depend on membership order, so equal IntSet's
+//     have equal hashSum's; it is kept up to date by every change of
+//     membership (append, remove, rebuildIndex, etc.).
+// (9) A shared buffer is a dynamic array obtained from allocate(),
+//     with a header stored just in front of data[0] that holds a
+//     reference count (the # of IntSet's whose data refers to it) and
+//     the size of the array. Copying an IntSet with a shared buffer
+//     (to an IntSet with an equal memory_resource) just shares the
+//     buffer (and copies the other members), so while the count is
+//     more than 1 the buffer is
+//     read-only: every function that changes data or index calls
+//     unshare() first, which gives the invoking IntSet a buffer of
+//     its own. A buffer is freed (by release()) when the last IntSet
+//     sharing it lets go of it. The count is atomic, so IntSet's that
+//     share a buffer may be copied, changed and destroyed in
+//     different threads (as long as each IntSet itself is used by one
+//     thread at a time, as with any other type).
+// (10) Every shared buffer of the IntSet was got from the
+//     memory_resource referenced by the member variable resource (or
+//     from one equal to it), and goes back to it.
 //
 // DOCUMENTATION for private member (helper) function:
 //   void resize(int new_capacity)
@@ -61,90 +107,449 @@
 //           is set to "the minimum that is needed" (which is the
 //           same as "exactly what is needed") to preserve current
 //           contents...
-//           ...BUT if "exactly what is needed" is 0 (i.e. existing
-//           collection is empty) then the capacity should be
-//           further adjusted to 1 or DEFAULT_CAPACITY (since we
-//           don't want to request dynamic arrays of size 0).
+//           ...BUT if "exactly what is needed" is INLINE_CAPACITY
+//           or less then the capacity is INLINE_CAPACITY and the
+//           entries are kept in inlineData (no dynamic array is
+//           requested for a small IntSet).
 //           The collection represented by the invoking IntSet
-//           remains unchanged.
+//           remains unchanged; removed entries are dropped and the
+//           index is rebuilt for the new capacity (entries and
+//           index are reallocated together as one array); the invoking
+//           IntSet no longer shares its old buffer (if it had one).
 //           If reallocation of dynamic array is unsuccessful, an
 //           error message to the effect is displayed and the
 //           program unconditionally terminated.
+//   void append(int anInt)
+//     Pre:  contains(anInt) returns false.
+//     Post: anInt has been added to the invoking IntSet as its newest
+//           element (the capacity is first grown by the growth factor
+//           if necessary) and sorted has been updated accordingly.
+//   void compact()
+//     Pre:  (none)
+//     Post: The removed entries of the invoking IntSet have been
+//           squeezed out (keeping the live ones in order) so that
+//           filled == used, and the index has been rebuilt.
+//   void rebuildIndex()
+//     Pre:  data[0] through data[filled - 1] are all live (i.e.,
+//           filled == used).
+//     Post: The slots of index have been refilled so that the index
+//           covers exactly data[0] through data[filled - 1] (nothing
+//           is done for a small IntSet, which has no index), and
+//           hashSum has been recomputed from those entries.
+//   int findSlot(int anInt) const
+//     Pre:  index is not null.
+//     Post: The slot of index that holds the entry for anInt is
+//           returned if anInt is a member, otherwise the empty slot
+//           where anInt's entry would go is returned.
+//   bool isLive(int pos) const
+//     Pre:  0 <= pos < filled and index is not null.
+//     Post: True is returned if data[pos] is a live entry, otherwise
+//           (data[pos] is a removed entry) false is returned.
+//   static unsigned mix(int anInt)
+//     Pre:  (none)
+//     Post: A well-mixed 32-bit hash of anInt (each bit of anInt
+//           affecting about half of the bits) is returned.
+//   static int bitsFor(int capacity)
+//     Pre:  (none)
+//     Post: The # of index bits needed to keep an index for capacity
+//           entries at most half full is returned.
+//   static int* allocate(int n, memory_resource* resource)
+//     Pre:  n > 0
+//     Post: A new shared buffer of n ints, with a reference count of 1,
+//           got from resource, is returned.
+//   static void release(int* buffer, memory_resource* resource)
+//     Pre:  buffer was returned by allocate() with resource (or with a
+//           memory_resource equal to it).
+//     Post: The reference count of buffer has been decremented, and
+//           buffer has been given back to resource if that left it at
+//           0.
+//   bool isShared() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking IntSet's buffer is shared
+//           with another IntSet, otherwise false is returned.
+//   void unshare()
+//     Pre:  (none)
+//     Post: The invoking IntSet has data (and index) of its own (a
+//           private copy of its buffer is made if it was shared), so
+//           it can be changed in place. The collection is unchanged.
+//   void takeFrom(IntSet& src)
+//     Pre:  The invoking IntSet is an empty small IntSet whose
+//           memory_resource is equal to src's.
+//     Post: The contents of src have been moved into the invoking
+//           IntSet (a shared buffer is taken over, the few entries of
+//           a small IntSet are copied) and src is an empty small
+//           IntSet.
+//   void keepIf(const IntSet& otherIntSet, bool inOther)
+//     Pre:  &otherIntSet != this
+//     Post: Only the elements of the invoking IntSet for which
+//           otherIntSet.contains(element) == inOther have been kept
+//           (in their existing order); no memory is allocated unless
+//           the invoking IntSet's buffer is shared.
+//
+// NOTE: After a remove leaves an IntSet with a capacity of more than
+//       SHRINK_MIN_CAPACITY at less than a quarter full, the capacity
+//       is halved, but never to less than SHRINK_MIN_CAPACITY (so a
+//       capacity of 33 to 63 drops to SHRINK_MIN_CAPACITY). Nothing
+//       else shrinks the capacity on its own (reset, &= and -= keep it
+//       for reuse; shrink_to_fit releases it).
+// NOTE: Growing past INLINE_CAPACITY moves the entries to a shared
+//       buffer (with an index); only shrink_to_fit moves them back
+//       inline (remove never halves the capacity below
+//       SHRINK_MIN_CAPACITY, which is above INLINE_CAPACITY).
 
 #include "IntSet.h"
+#include "SetKernels.h"
+#include "HashIndex.h"
 #include <iostream>
+#include <utility>
+#include <atomic>
+#include <new>
 #include <cassert>
 using namespace std;
 
+double IntSet::growthFactor = 1.5;
+
+// the header in front of a shared buffer: its reference count, and
+// its # of ints (to give the right # of bytes back to its
+// memory_resource)
+struct BufferHeader
+{
+    atomic<int> refs;
+    int ints;
+};
+
+static BufferHeader& header(int* buffer)
+{
+    return *(reinterpret_cast<BufferHeader*>(buffer) - 1);
+}
+
+static atomic<int>& refCount(int* buffer)
+{
+    return header(buffer).refs;
+}
+
+static_assert(sizeof(BufferHeader) % sizeof(int) == 0,
+              "a shared buffer's ints must be aligned after its header");
+
+int* IntSet::allocate(int n, memory_resource* resource)
+{
+    void* block = resource->allocate(sizeof(BufferHeader) + n * sizeof(int));
+    BufferHeader* head = new (block) BufferHeader;
+    head->refs.store(1, memory_order_relaxed);
+    head->ints = n;
+    return reinterpret_cast<int*>(head + 1);
+}
+
+void IntSet::release(int* buffer, memory_resource* resource)
+{
+    BufferHeader& head = header(buffer);
+    if (head.refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        size_t bytes = sizeof(BufferHeader) + head.ints * sizeof(int);
+        head.~BufferHeader();
+        resource->deallocate(&head, bytes);
+    }
+}
+
+bool IntSet::isShared() const
+{
+    return data != inlineData &&
+           refCount(data).load(memory_order_acquire) > 1;
+}
+
+void IntSet::unshare()
+{
+    if (isShared())
+    {
+        resize(capacity);   // copies into a buffer of its own
+    }
+}
+
 void IntSet::resize(int new_capacity)
 {
     if (new_capacity < used)
     {
         new_capacity = used;
     }
-    if (new_capacity < DEFAULT_CAPACITY)
+    if (new_capacity < INLINE_CAPACITY)
     {
-        new_capacity = DEFAULT_CAPACITY;
+        new_capacity = INLINE_CAPACITY;
     }
-    
-    capacity = new_capacity;
-    
-    int* temp = new int[capacity];
-    
-    for (int i = 0; i < used; i++)
+    if (new_capacity == INLINE_CAPACITY && index == 0)
+    {
+        return;     // small IntSet staying small
+    }
+
+    int bits = 0;
+    int* temp = inlineData;
+    if (new_capacity > INLINE_CAPACITY)
+    {
+        bits = bitsFor(new_capacity);
+        temp = allocate(new_capacity + (1 << bits), resource);
+    }
+    int count = 0;
+
+    for (int i = 0; i < filled; i++)
+    {
+        if (filled == used || isLive(i))
+        {
+            temp[count++] = data[i];
+        }
+    }
+
+    if (data != inlineData)
     {
-        temp[i] = data[i];
+        release(data, resource);
     }
-    
-    delete [] data;
     data = temp;
+    capacity = new_capacity;
+    index = (data == inlineData) ? 0 : data + capacity;
+    indexBits = bits;
+    filled = count;
+    rebuildIndex();
+}
+
+void IntSet::append(int anInt)
+{
+    if (capacity <= filled)
+    {
+        int newCapacity = int(growthFactor * capacity);
+        if (newCapacity <= capacity)
+        {
+            newCapacity = capacity + 1;
+        }
+        resize(newCapacity);
+    }
+    else
+    {
+        unshare();
+    }
+    if (filled > 0 && anInt < data[filled - 1])
+    {
+        sorted = false;
+    }
+    data[filled] = anInt;
+    filled = filled + 1;
+    if (index != 0)
+    {
+        index[findSlot(anInt)] = filled;
+    }
+    used = used + 1;
+    hashSum += mix(anInt);
+}
+
+void IntSet::compact()
+{
+    if (filled == used)
+    {
+        return;
+    }
+    unshare();
+
+    int count = 0;
+    for (int i = 0; i < filled; i++)
+    {
+        if (isLive(i))
+        {
+            data[count++] = data[i];
+        }
+    }
+    filled = count;
+    rebuildIndex();
+}
+
+void IntSet::rebuildIndex()
+{
+    hashSum = 0;
+    for (int i = 0; i < filled; i++)
+    {
+        hashSum += mix(data[i]);
+    }
+    if (index == 0)
+    {
+        return;
+    }
+    hashClear(index, indexBits);
+    for (int i = 0; i < filled; i++)
+    {
+        index[findSlot(data[i])] = i + 1;
+    }
+}
+
+unsigned IntSet::mix(int anInt)
+{
+    unsigned h = unsigned(anInt);
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+int IntSet::findSlot(int anInt) const
+{
+    const int* entries = data;
+    return hashFindSlot(index, indexBits, unsigned(anInt),
+                        [entries, anInt](int p) { return entries[p] == anInt; });
 }
 
-IntSet::IntSet(int initial_capacity) : capacity(initial_capacity), used(0)
+bool IntSet::isLive(int pos) const
 {
-    if (initial_capacity < 1)
+    return index[findSlot(data[pos])] == pos + 1;
+}
+
+int IntSet::bitsFor(int capacity)
+{
+    return hashIndexBits(capacity);
+}
+
+IntSet::IntSet(int initial_capacity, memory_resource* resource)
+    : data(inlineData), capacity(INLINE_CAPACITY), used(0), filled(0), index(0), indexBits(0), sorted(true), hashSum(0), resource(resource)
+{
+    if (initial_capacity > INLINE_CAPACITY)
     {
-        capacity = DEFAULT_CAPACITY;
+        resize(initial_capacity);
     }
-    capacity = initial_capacity;
-    data = new int[initial_capacity];
 }
 
-IntSet::IntSet(const IntSet& src) : capacity(src.capacity), used(src.used)
+IntSet::IntSet(const int* first, const int* last, memory_resource* resource)
+    : IntSet(int(last - first), resource)
 {
-    data = new int[capacity];
-    
-    for (int i = 0; i < used; i++)
+    add_range(first, last);
+}
+
+IntSet::IntSet(const IntSet& src, memory_resource* resource)
+    : data(inlineData), capacity(INLINE_CAPACITY), used(src.used), filled(src.used), index(0), indexBits(0), sorted(src.sorted), hashSum(src.hashSum), resource(resource)
+{
+    if (used > INLINE_CAPACITY && resource->is_equal(*src.resource))
     {
-        data[i] = src.data[i];
+        // share src's buffer (removed entries and all); it is copied
+        // only when one of the two IntSets is changed
+        refCount(src.data).fetch_add(1, memory_order_relaxed);
+        data = src.data;
+        capacity = src.capacity;
+        filled = src.filled;
+        index = src.index;
+        indexBits = src.indexBits;
+        return;
     }
+
+    if (used > INLINE_CAPACITY)
+    {
+        // src's buffer belongs to another memory_resource: copy the
+        // members into a buffer (just big enough) of our own
+        capacity = used;
+        indexBits = bitsFor(capacity);
+        data = allocate(capacity + (1 << indexBits), resource);
+        index = data + capacity;
+    }
+
+    // otherwise few enough members to copy them inline
+    int count = 0;
+    for (int i = 0; i < src.filled; i++)
+    {
+        if (src.filled == src.used || src.isLive(i))
+        {
+            data[count++] = src.data[i];
+        }
+    }
+    if (index != 0)
+    {
+        rebuildIndex();
+    }
+}
+
+IntSet::IntSet(IntSet&& src) noexcept
+    : data(inlineData), capacity(INLINE_CAPACITY), used(0), filled(0), index(0), indexBits(0), sorted(true), hashSum(0), resource(src.resource)
+{
+    takeFrom(src);
 }
 
 IntSet::~IntSet()
 {
-    delete [] data;
+    if (data != inlineData)
+    {
+        release(data, resource);
+    }
 }
 
 IntSet& IntSet::operator=(const IntSet& rhs)
 {
     if (this != &rhs)
     {
-        int* temp = new int[rhs.capacity];
-        capacity = rhs.capacity;
-        used = rhs.used;
-        
-        for (int i = 0; i < rhs.used; i++)
+        IntSet temp(rhs, resource);
+        *this = std::move(temp);
+    }
+
+    return *this;
+}
+
+IntSet& IntSet::operator=(IntSet&& rhs)
+{
+    if (this != &rhs && rhs.data != rhs.inlineData &&
+        !resource->is_equal(*rhs.resource))
+    {
+        // rhs's buffer can't be taken over by an IntSet of another
+        // memory_resource: copy the members (the one step that can
+        // throw, before anything has changed), then empty rhs as a
+        // move would
+        IntSet temp(rhs, resource);
+        IntSet emptied(std::move(rhs));
+        *this = std::move(temp);
+    }
+    else if (this != &rhs)
+    {
+        if (data != inlineData)
         {
-            temp[i] = rhs.data[i];
+            release(data, resource);
         }
-        
-        delete [] data;
-        data = temp;
+        data = inlineData;
+        capacity = INLINE_CAPACITY;
+        index = 0;
+        indexBits = 0;
+        takeFrom(rhs);
     }
-    
+
     return *this;
 }
 
+void IntSet::takeFrom(IntSet& src) noexcept
+{
+    if (src.data == src.inlineData)
+    {
+        for (int i = 0; i < src.used; i++)
+        {
+            inlineData[i] = src.inlineData[i];
+        }
+    }
+    else
+    {
+        data = src.data;
+        capacity = src.capacity;
+        index = src.index;
+        indexBits = src.indexBits;
+    }
+    used = src.used;
+    filled = src.filled;
+    sorted = src.sorted;
+    hashSum = src.hashSum;
+
+    src.data = src.inlineData;
+    src.capacity = INLINE_CAPACITY;
+    src.used = 0;
+    src.filled = 0;
+    src.index = 0;
+    src.indexBits = 0;
+    src.sorted = true;
+    src.hashSum = 0;
+}
+
+memory_resource* IntSet::get_resource() const
+{
+    return resource;
+}
+
 int IntSet::size() const
 {
     return used;
@@ -168,16 +573,29 @@ bool IntSet::contains(int anInt) const
     {
         return false;
     }
-    
-    for (int i = 0; i < used; i++)
+    if (index == 0)
     {
-        if (data[i] == anInt)
+        for (int i = 0; i < used; i++)
         {
-            return true;
+            if (data[i] == anInt)
+            {
+                return true;
+            }
         }
+        return false;
     }
-    
-    return false;
+
+    return index[findSlot(anInt)] != 0;
+}
+
+bool IntSet::isSorted() const
+{
+    return sorted;
+}
+
+unsigned IntSet::fingerprint() const
+{
+    return hashSum;
 }
 
 bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
@@ -190,119 +608,267 @@ bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
     {
         return false;
     }
-    
-    int counter = 0;
-    for (int i = 0; i < used; i++)
+    if (used == otherIntSet.used)
     {
-        if (otherIntSet.contains(data[i]))
+        // a subset of the same size is the same set
+        if (hashSum != otherIntSet.hashSum)
+        {
+            return false;
+        }
+        if (sorted && otherIntSet.sorted &&
+            filled == used && otherIntSet.filled == otherIntSet.used)
         {
-            counter++;
+            // same sorted members means the very same entries
+            for (int i = 0; i < used; i++)
+            {
+                if (data[i] != otherIntSet.data[i])
+                {
+                    return false;
+                }
+            }
+            return true;
         }
     }
-    if (used == counter)
+
+    for (int i = 0; i < filled; i++)
     {
-        return true;
+        if ((filled == used || isLive(i)) &&
+            !otherIntSet.contains(data[i]))
+        {
+            return false;
+        }
     }
-    else
+    return true;
+}
+
+IntSet::const_iterator::const_iterator() : set(0), pos(0) { }
+
+IntSet::const_iterator::const_iterator(const IntSet* owner, int start)
+    : set(owner), pos(start)
+{
+    skipRemoved();
+}
+
+void IntSet::const_iterator::skipRemoved()
+{
+    if (set->filled != set->used)
     {
-        return false;
+        while (pos < set->filled && !set->isLive(pos))
+        {
+            pos++;
+        }
     }
 }
 
+const int& IntSet::const_iterator::operator*() const
+{
+    return set->data[pos];
+}
+
+const int* IntSet::const_iterator::operator->() const
+{
+    return set->data + pos;
+}
+
+IntSet::const_iterator& IntSet::const_iterator::operator++()
+{
+    pos++;
+    skipRemoved();
+    return *this;
+}
+
+IntSet::const_iterator IntSet::const_iterator::operator++(int)
+{
+    const_iterator before = *this;
+    ++*this;
+    return before;
+}
+
+bool IntSet::const_iterator::operator==(const const_iterator& rhs) const
+{
+    return pos == rhs.pos && set == rhs.set;
+}
+
+bool IntSet::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return !(*this == rhs);
+}
+
+IntSet::const_iterator IntSet::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+IntSet::const_iterator IntSet::end() const
+{
+    return const_iterator(this, filled);
+}
+
 void IntSet::DumpData(ostream& out) const
-{  // already implemented ... DON'T change anything
-    if (used > 0)
+{
+    bool first = true;
+    for (int i = 0; i < filled; ++i)
     {
-        out << data[0];
-        for (int i = 1; i < used; ++i)
-            out << "  " << data[i];
+        if (filled == used || isLive(i))
+        {
+            if (!first)
+                out << "  ";
+            out << data[i];
+            first = false;
+        }
     }
 }
 
-IntSet IntSet::unionWith(const IntSet& otherIntSet) const
+IntSet IntSet::unionWith(const IntSet& otherIntSet) const &
 {
-    IntSet temp = *this;
-    
-    for (int i = 0; i < otherIntSet.used; i++)
+    if (sorted && otherIntSet.sorted &&
+        filled == used && otherIntSet.filled == otherIntSet.used)
     {
-        temp.add(otherIntSet.data[i]);
+        // members of otherIntSet not already in *this keep their
+        // relative order and come after all members of *this
+        IntSet temp(used + otherIntSet.used, resource);
+        for (int i = 0; i < used; i++)
+        {
+            temp.data[i] = data[i];
+        }
+        int added = sortedSubtract(otherIntSet.data, otherIntSet.used,
+                                   data, used, temp.data + used);
+        temp.filled = temp.used = used + added;
+        temp.sorted = (used == 0 || added == 0 ||
+                       temp.data[used - 1] < temp.data[used]);
+        temp.rebuildIndex();
+        return temp;
     }
-    
+
+    // one allocation: room for every element of both IntSets
+    IntSet temp(used + otherIntSet.used, resource);
+    for (int i = 0; i < filled; i++)
+    {
+        if (filled == used || isLive(i))
+        {
+            temp.data[temp.filled++] = data[i];
+        }
+    }
+    temp.used = temp.filled;
+    temp.sorted = sorted;
+    temp.rebuildIndex();
+    temp |= otherIntSet;
     return temp;
 }
 
-IntSet IntSet::intersect(const IntSet& otherIntSet) const
+IntSet IntSet::intersect(const IntSet& otherIntSet) const &
 {
-    IntSet temp;
-    int tempSize = size() + (otherIntSet.subtract(*this)).size();
-    
-    for (int i = 0; i < tempSize; i++)
+    if (sorted && otherIntSet.sorted &&
+        filled == used && otherIntSet.filled == otherIntSet.used)
+    {
+        IntSet temp(used < otherIntSet.used ? used : otherIntSet.used,
+                    resource);
+        temp.filled = temp.used =
+            sortedIntersect(data, used, otherIntSet.data,
+                            otherIntSet.used, temp.data);
+        temp.rebuildIndex();
+        return temp;
+    }
+
+    IntSet temp(used < otherIntSet.used ? used : otherIntSet.used,
+                    resource);
+
+    for (int i = 0; i < filled; i++)
     {
-        if (contains(data[i]) && otherIntSet.contains(data[i]))
+        if ((filled == used || isLive(i)) && otherIntSet.contains(data[i]))
         {
-            temp.add(data[i]);
+            temp.append(data[i]);
         }
     }
-    
+
     return temp;
 }
 
-IntSet IntSet::subtract(const IntSet& otherIntSet) const
+IntSet IntSet::subtract(const IntSet& otherIntSet) const &
 {
-    IntSet temp;
-    
-    for (int i = 0; i < used; i++)
+    if (sorted && otherIntSet.sorted &&
+        filled == used && otherIntSet.filled == otherIntSet.used)
+    {
+        IntSet temp(used, resource);
+        temp.filled = temp.used =
+            sortedSubtract(data, used, otherIntSet.data,
+                           otherIntSet.used, temp.data);
+        temp.rebuildIndex();
+        return temp;
+    }
+
+    IntSet temp(used, resource);
+
+    for (int i = 0; i < filled; i++)
     {
-        if (!otherIntSet.contains(data[i]))
+        if ((filled == used || isLive(i)) && !otherIntSet.contains(data[i]))
         {
-            temp.add(data[i]);
+            temp.append(data[i]);
         }
     }
     return temp;
 }
 
+IntSet IntSet::unionWith(const IntSet& otherIntSet) &&
+{
+    *this |= otherIntSet;
+    return std::move(*this);
+}
+
+IntSet IntSet::intersect(const IntSet& otherIntSet) &&
+{
+    *this &= otherIntSet;
+    return std::move(*this);
+}
+
+IntSet IntSet::subtract(const IntSet& otherIntSet) &&
+{
+    *this -= otherIntSet;
+    return std::move(*this);
+}
+
 void IntSet::reset()
 {
+    if (isShared())
+    {
+        // let the other IntSet's keep the buffer rather than copy it
+        release(data, resource);
+        data = inlineData;
+        capacity = INLINE_CAPACITY;
+        index = 0;
+        indexBits = 0;
+    }
     used = 0;
+    filled = 0;
+    sorted = true;
+    rebuildIndex();
 }
 
 bool IntSet::add(int anInt)
 {
+    // a value above the newest entry of a sorted IntSet can't
+    // already be a member
+    if (sorted && (filled == 0 || data[filled - 1] < anInt))
+    {
+        append(anInt);
+        return true;
+    }
     if (contains(anInt))
     {
         return false;
     }
     else
     {
-        if (capacity <= used)
-        {
-            int newCapacity = (1.5 * capacity);
-            if (newCapacity == capacity)
-            {
-                newCapacity = capacity + 1;
-            }
-            resize(newCapacity);
-            data[used] = anInt;
-            used = used + 1;
-            return true;
-        }
-        else
-        {
-            data[used] = anInt;
-            used = used + 1;
-            return true;
-        }
+        append(anInt);
+        return true;
     }
 }
 
 bool IntSet::remove(int anInt)
 {
-    if (!contains(anInt))
-    {
-        return false;
-    }
-    else
+    if (index == 0)
     {
+        // small IntSet: no index, so just close the gap
         for (int i = 0; i < used; i++)
         {
             if (data[i] == anInt)
@@ -311,17 +877,192 @@ bool IntSet::remove(int anInt)
                 {
                     data[j] = data[j + 1];
                 }
+                used = used - 1;
+                filled = used;
+                hashSum -= mix(anInt);
+                return true;
             }
         }
+        return false;
+    }
+    if (!contains(anInt))
+    {
+        return false;
+    }
+    else
+    {
+        unshare();
+
+        // backward-shift deletion of the entry's slot
+        const int* entries = data;
+        int slot = findSlot(anInt);
+        int pos = index[slot] - 1;
+        hashEraseSlot(index, indexBits, slot,
+                      [entries](int p) { return unsigned(entries[p]); });
         used = used - 1;
+        hashSum -= mix(anInt);
+
+        if (pos == filled - 1)
+        {
+            filled = filled - 1;
+        }
+        if (filled - used > used)
+        {
+            compact();
+        }
+        if (capacity > SHRINK_MIN_CAPACITY && used < capacity / 4)
+        {
+            int half = capacity / 2;
+            if (half < SHRINK_MIN_CAPACITY)
+            {
+                half = SHRINK_MIN_CAPACITY;
+            }
+            resize(half);
+        }
         return true;
     }
 }
 
-bool operator==(const IntSet& is1, const IntSet& is2)
+int IntSet::add_range(const int* first, const int* last)
 {
-    if (is1.isSubsetOf(is2) && is2.isSubsetOf(is1))
-        return true;
+    if (first == last)
+    {
+        return 0;
+    }
+
+    int before = used;
+    reserve(filled + int(last - first));
+    unshare();
+    if (index == 0)
+    {
+        for (const int* p = first; p != last; ++p)
+        {
+            add(*p);
+        }
+        return used - before;
+    }
+
+    // with the room reserved no resize can move things around, so
+    // the slot found for a value is where its entry goes
+    for (const int* p = first; p != last; ++p)
+    {
+        int s = findSlot(*p);
+        if (index[s] == 0)
+        {
+            if (filled > 0 && *p < data[filled - 1])
+            {
+                sorted = false;
+            }
+            data[filled] = *p;
+            filled = filled + 1;
+            index[s] = filled;
+            used = used + 1;
+            hashSum += mix(*p);
+        }
+    }
+    return used - before;
+}
+
+int IntSet::remove_all(const IntSet& otherIntSet)
+{
+    int before = used;
+    *this -= otherIntSet;
+    return before - used;
+}
+
+void IntSet::reserve(int n)
+{
+    if (capacity < n)
+    {
+        resize(n);
+    }
+}
+
+void IntSet::shrink_to_fit()
+{
+    if (capacity > used && capacity > INLINE_CAPACITY)
+    {
+        resize(used);
+    }
+}
+
+void IntSet::set_growth_factor(double factor)
+{
+    if (factor > 1.0)
+    {
+        growthFactor = factor;
+    }
+}
+
+double IntSet::growth_factor()
+{
+    return growthFactor;
+}
+
+IntSet& IntSet::operator|=(const IntSet& otherIntSet)
+{
+    if (this != &otherIntSet)
+    {
+        reserve(filled + otherIntSet.used);
+        for (int i = 0; i < otherIntSet.filled; i++)
+        {
+            if (otherIntSet.filled == otherIntSet.used || otherIntSet.isLive(i))
+            {
+                add(otherIntSet.data[i]);
+            }
+        }
+    }
+    return *this;
+}
+
+IntSet& IntSet::operator&=(const IntSet& otherIntSet)
+{
+    if (this != &otherIntSet)
+    {
+        keepIf(otherIntSet, true);
+    }
+    return *this;
+}
+
+IntSet& IntSet::operator-=(const IntSet& otherIntSet)
+{
+    if (this != &otherIntSet)
+    {
+        keepIf(otherIntSet, false);
+    }
     else
+    {
+        reset();
+    }
+    return *this;
+}
+
+void IntSet::keepIf(const IntSet& otherIntSet, bool inOther)
+{
+    unshare();
+    compact();
+
+    int count = 0;
+    for (int i = 0; i < filled; i++)
+    {
+        if (otherIntSet.contains(data[i]) == inOther)
+        {
+            data[count++] = data[i];
+        }
+    }
+    if (count != filled)
+    {
+        filled = used = count;
+        rebuildIndex();
+    }
+}
+
+bool operator==(const IntSet& is1, const IntSet& is2)
+{
+    // same size and subset is enough; isSubsetOf checks the
+    // fingerprints first, so unequal IntSet's are usually told
+    // apart in O(1) time
+    if (is1.size() != is2.size() || is1.fingerprint() != is2.fingerprint())
         return false;
+    return is1.isSubsetOf(is2);
 }
@@ -9,18 +9,45 @@
 //     IntSet::DEFAULT_CAPACITY is the highest # of distinct
 //     values "an IntSet created by the default constructor"
 //     can accommodate).
+//   static const int INLINE_CAPACITY = 16
+//     IntSet::INLINE_CAPACITY is the # of elements an IntSet can
+//     hold in storage of its own, without allocating any memory;
+//     the capacity of an IntSet is never less than this.
 //
-// CONSTRUCTOR
-//   IntSet(int initial_capacity = DEFAULT_CAPACITY)
+// CONSTRUCTORS
+//   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+//          memory_resource* resource = new_delete_resource())
+//     Pre:  resource (see MemoryResource.h) outlasts the IntSet.
 //     Post: The invoking IntSet is initialized to an empty
 //           IntSet (i.e., one containing no relevant elements);
 //           the initial capacity is given by initial_capacity if
-//           initial_capacity is >= 1, otherwise it is given by
-//           IntSet:DEFAULT_CAPACITY.
+//           initial_capacity is > INLINE_CAPACITY, otherwise it is
+//           INLINE_CAPACITY (and no memory is allocated).
 //     Note: When the IntSet is put to use after construction,
-//           its capacity will be resized as necessary.
+//           its capacity will be resized as necessary: it grows by
+//           the growth factor (see set_growth_factor) when full and
+//           is halved when a remove leaves it less than a quarter
+//           full (small IntSets excepted).
+//     Note: All of the IntSet's memory (beyond its inline storage) is
+//           got from resource; so is that of the IntSet's returned by
+//           its unionWith, intersect and subtract.
+//   IntSet(const int* first, const int* last,
+//          memory_resource* resource = new_delete_resource())
+//     Pre:  [first, last) is a valid range of int values (first ==
+//           last for an empty range), and resource outlasts the
+//           IntSet.
+//     Post: The invoking IntSet is initialized to contain the
+//           distinct values of the range, with membership timing
+//           given by each value's first occurrence in the range.
+//     Note: Same as constructing an empty IntSet and calling
+//           add_range(first, last); takes O(n) expected time and one
+//           allocation for a range of n values.
 //
 // CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   memory_resource* get_resource() const
+//     Pre:  (none)
+//     Post: The memory_resource the invoking IntSet gets its memory
+//           from is returned.
 //   int size() const
 //     Pre:  (none)
 //     Post: Number of elements in the invoking IntSet is returned.
@@ -32,6 +59,25 @@
 //     Pre:  (none)
 //     Post: true is returned if the invoking IntSet has anInt as an
 //           element, otherwise false is returned.
+//     Note: Takes O(1) expected time (members are looked up through
+//           a hash index kept alongside the membership-ordered
+//           values).
+//   bool isSorted() const
+//     Pre:  (none)
+//     Post: True is returned if the elements of the invoking IntSet
+//           (in order of membership timing) are in ascending order,
+//           otherwise false is returned.
+//     Note: An IntSet whose elements were all added in ascending
+//           order is in sorted form. When both operands are in
+//           sorted form, unionWith, intersect and subtract run in
+//           linear time using the kernels of SetKernels.h.
+//   unsigned fingerprint() const
+//     Pre:  (none)
+//     Post: An order-independent hash of the elements of the invoking
+//           IntSet is returned: equal IntSet's have equal fingerprints
+//           (so IntSet's with different fingerprints are not equal).
+//     Note: Kept up to date by every operation that changes the
+//           elements, so it takes O(1) time.
 //   bool isSubsetOf(const IntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: True is returned if all elements of the invoking IntSet
@@ -40,6 +86,9 @@
 //           By definition, true is returned if the invoking IntSet
 //           is empty (i.e., an empty IntSet is always isSubsetOf
 //           another IntSet, even if the other IntSet is also empty).
+//     Note: Takes O(n) expected time for n elements of the invoking
+//           IntSet, and O(1) time when the two IntSets have the same
+//           size but different fingerprints.
 //   void DumpData(std::ostream& out) const
 //     Pre:  (none)
 //     Post: Contents of the invoking IntSet have been inserted into
@@ -69,6 +118,18 @@
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all elements of
 //           otherIntSet removed.
+//     Note: unionWith, intersect and subtract take time linear in
+//           the sizes of the two IntSets.
+//   IntSet unionWith(const IntSet& otherIntSet) &&
+//   IntSet intersect(const IntSet& otherIntSet) &&
+//   IntSet subtract(const IntSet& otherIntSet) &&
+//     Pre:  (none)
+//     Post: Same as above, but the invoking IntSet (a temporary, or
+//           an IntSet passed through std::move) is updated in place
+//           with |=, &= or -= and then moved into the IntSet that is
+//           returned, so its storage is reused; e.g., in
+//           a.unionWith(b).intersect(c).subtract(d) only the first
+//           operation makes a new IntSet.
 //
 // MODIFICATION MEMBER FUNCTIONS (MUTATORS)
 //   void reset()
@@ -87,6 +148,84 @@
 //           removed from the invoking IntSet and true is
 //           returned, otherwise the invoking IntSet is unchanged
 //           and false is returned.
+//     Note: add and remove take O(1) amortized expected time; the
+//           membership timing of the remaining elements is never
+//           affected by a removal.
+//   int add_range(const int* first, const int* last)
+//     Pre:  [first, last) is a valid range of int values (first ==
+//           last for an empty range).
+//     Post: Each value of the range has been added (as if by add, in
+//           the order of the range) and the # of values that were
+//           actually added as new elements is returned.
+//     Note: Room for the whole range is reserved first, so at most
+//           one allocation is made, and each value is hash-checked
+//           (duplicates, both within the range and against existing
+//           elements, are dropped in one pass that keeps
+//           membership timing).
+//   int remove_all(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: All elements of otherIntSet have been removed from the
+//           invoking IntSet (as by -=) and the # of elements that
+//           were actually removed is returned.
+//   IntSet& operator|=(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: All elements of otherIntSet have been added to the
+//           invoking IntSet (which becomes what unionWith would have
+//           returned) and the invoking IntSet is returned.
+//   IntSet& operator&=(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: All elements of the invoking IntSet that are not also
+//           elements of otherIntSet have been removed (the invoking
+//           IntSet becomes what intersect would have returned) and
+//           the invoking IntSet is returned.
+//   IntSet& operator-=(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: All elements of otherIntSet have been removed from the
+//           invoking IntSet (which becomes what subtract would have
+//           returned) and the invoking IntSet is returned.
+//     Note: &= and -= don't allocate memory (unless the invoking
+//           IntSet shares its storage with a copy; see VALUE
+//           SEMANTICS); |= allocates at most once, when the invoking
+//           IntSet has to grow.
+//   void reserve(int n)
+//     Pre:  (none)
+//     Post: The capacity of the invoking IntSet is at least n, so
+//           it can hold n elements without allocating any more
+//           memory. The collection is unchanged.
+//   void shrink_to_fit()
+//     Pre:  (none)
+//     Post: The capacity of the invoking IntSet has been reduced to
+//           its size (or to INLINE_CAPACITY if it is smaller),
+//           releasing memory no longer needed (such as after a
+//           reset). The collection is unchanged.
+//
+// ITERATORS
+//   class const_iterator
+//     A forward iterator (std::forward_iterator_tag) over the elements
+//     of an IntSet in order of membership timing; *it is a const int&.
+//     Any change to the IntSet (other than through a const member
+//     function) invalidates its iterators.
+//   const_iterator begin() const
+//     Pre:  (none)
+//     Post: An iterator to the element with earliest membership is
+//           returned (end() if the IntSet is empty).
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: The past-the-end iterator of the IntSet is returned.
+//     Note: With begin() and end(), an IntSet can be used with the
+//           standard algorithms and range-based for loops, and as an
+//           operand of the lazy views of IntSetViews.h.
+//
+// STATIC MEMBER FUNCTIONS
+//   static void set_growth_factor(double factor)
+//     Pre:  factor > 1.0
+//     Post: The factor by which a full IntSet's capacity is grown is
+//           set to factor (for all IntSet's; the initial factor is
+//           1.5). If Pre is not met, the factor is left unchanged.
+//   static double growth_factor()
+//     Pre:  (none)
+//     Post: The factor by which a full IntSet's capacity is grown is
+//           returned.
 //
 // NON-MEMBER FUNCTIONS
 //   bool operator==(const IntSet& is1, const IntSet& is2)
@@ -95,41 +234,146 @@
 //           otherwise false is returned; for e.g.: {1,2,3}, {1,3,2},
 //           {2,1,3}, {2,3,1}, {3,1,2}, and {3,2,1} are all equal.
 //     Note: By definition, two empty IntSet's are equal.
+//     Note: IntSet's of different sizes or fingerprints are told
+//           apart in O(1) time; otherwise O(n) expected time.
 //
 // VALUE SEMANTICS
 //   Assignment and the copy constructor may be used with IntSet
-//   objects.
+//   objects. IntSet's can also be moved (move construction and move
+//   assignment take the storage of the source without allocating, and
+//   just copy the elements of a small IntSet held inline);
+//   an IntSet that has been moved from is empty and may be used
+//   like any other empty IntSet.
+//   Copies are copy-on-write: a copy of an IntSet with more than
+//   INLINE_CAPACITY elements shares the source's storage (a reference
+//   count is kept with it) instead of copying it, so copying (by the
+//   copy constructor, assignment or passing by value) takes O(1) time
+//   and no memory. The storage is copied, once, by the first change to
+//   either IntSet (add, remove, reset, |=, &=, -=, etc.) that happens
+//   while it is still shared; reset of a shared IntSet just lets go of
+//   the storage. Smaller IntSet's are copied as before (their elements
+//   are held inline). Sharing is not visible otherwise: a change to one
+//   IntSet never affects another, and IntSet's that share storage may
+//   be used in different threads.
+//   Memory resources: IntSet(const IntSet& src, memory_resource*
+//   resource = new_delete_resource()) makes a copy that gets its memory
+//   from resource (so, as with the standard containers, a plain copy
+//   of an IntSet backed by an arena is not, and may outlast the
+//   arena); only IntSet's with equal memory_resource's share storage.
+//   Assignment keeps the invoking IntSet's memory_resource; a move
+//   takes over the source's storage only if their memory_resource's
+//   are equal (otherwise its elements are copied), and the move
+//   constructor gives the new IntSet the source's memory_resource.
+//   So the move constructor never allocates and is noexcept, but move
+//   assignment is not: between IntSet's with unequal memory_resource's
+//   it allocates, and may throw std::bad_alloc (leaving both IntSet's
+//   unchanged). Containers such as std::vector<IntSet> move their
+//   elements when they reallocate (that takes the move constructor).
 
 #ifndef INT_SET_H
 #define INT_SET_H
 
 #include <iostream>
+#include <iterator>   // provides std::forward_iterator_tag
+#include <cstddef>    // provides std::ptrdiff_t
+#include "MemoryResource.h"
 
 class IntSet
 {
 public:
-   static const int DEFAULT_CAPACITY = 1;
-   IntSet(int initial_capacity = DEFAULT_CAPACITY);
-   IntSet(const IntSet& src);
+   static const int INLINE_CAPACITY = 16;
+   static const int DEFAULT_CAPACITY = INLINE_CAPACITY;
+   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+          memory_resource* resource = new_delete_resource());
+   IntSet(const int* first, const int* last,
+          memory_resource* resource = new_delete_resource());
+   IntSet(const IntSet& src,
+          memory_resource* resource = new_delete_resource());
+   IntSet(IntSet&& src) noexcept;
    ~IntSet();
    IntSet& operator=(const IntSet& rhs);
+   IntSet& operator=(IntSet&& rhs);
+
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef int value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const int* pointer;
+      typedef const int& reference;
+      const_iterator();
+      reference operator*() const;
+      pointer operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+   private:
+      friend class IntSet;
+      const IntSet* set;
+      int pos;
+      const_iterator(const IntSet* owner, int start);
+      void skipRemoved();
+   };
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   memory_resource* get_resource() const;
    int size() const;
    bool isEmpty() const;
    bool contains(int anInt) const;
+   bool isSorted() const;
+   unsigned fingerprint() const;
    bool isSubsetOf(const IntSet& otherIntSet) const;
    void DumpData(std::ostream& out) const;
-   IntSet unionWith(const IntSet& otherIntSet) const;
-   IntSet intersect(const IntSet& otherIntSet) const;
-   IntSet subtract(const IntSet& otherIntSet) const;
+   IntSet unionWith(const IntSet& otherIntSet) const &;
+   IntSet intersect(const IntSet& otherIntSet) const &;
+   IntSet subtract(const IntSet& otherIntSet) const &;
+   IntSet unionWith(const IntSet& otherIntSet) &&;
+   IntSet intersect(const IntSet& otherIntSet) &&;
+   IntSet subtract(const IntSet& otherIntSet) &&;
    void reset();
    bool add(int anInt);
    bool remove(int anInt);
+   int add_range(const int* first, const int* last);
+   int remove_all(const IntSet& otherIntSet);
+   IntSet& operator|=(const IntSet& otherIntSet);
+   IntSet& operator&=(const IntSet& otherIntSet);
+   IntSet& operator-=(const IntSet& otherIntSet);
+   void reserve(int n);
+   void shrink_to_fit();
+   static void set_growth_factor(double factor);
+   static double growth_factor();
 
 private:
+   friend class ParallelSetOps;   // (see ParallelSetOps.h)
+   static const int SHRINK_MIN_CAPACITY = 32;
+   static double growthFactor;
+   int  inlineData[INLINE_CAPACITY];
    int* data;
    int  capacity;
    int  used;
+   int  filled;
+   int* index;
+   int  indexBits;
+   bool sorted;
+   unsigned hashSum;
+   memory_resource* resource;
    void resize(int new_capacity);
+   void append(int anInt);
+   void compact();
+   void rebuildIndex();
+   int findSlot(int anInt) const;
+   bool isLive(int pos) const;
+   static unsigned mix(int anInt);
+   static int bitsFor(int capacity);
+   static int* allocate(int n, memory_resource* resource);
+   static void release(int* buffer, memory_resource* resource);
+   bool isShared() const;
+   void unshare();
+   void takeFrom(IntSet& src) noexcept;
+   void keepIf(const IntSet& otherIntSet, bool inOther);
 };
 
 bool operator==(const IntSet& is1, const IntSet& is2);
@@ -0,0 +1,302 @@
+// FILE: IntSetBatch.cpp
+//       Implementation file for the IntSet batch command engine
+//       (See IntSetBatch.h for documentation.)
+//
+// The command file is parsed straight from memory (no iostream
+// extraction, no prompts or echo). The values of a command are parsed
+// before any of them is handed to the IntSet, so that only the IntSet
+// operations themselves are inside the timed part; the output commands
+// (z and d) are not timed at all.
+
+#include "IntSetBatch.h"
+#include "IntSet.h"
+#include <cstdlib>
+#include <cerrno>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+namespace
+{
+   typedef chrono::steady_clock batch_clock;
+
+   struct OpStats
+   {
+      long   commands;
+      long   elements;
+      long   trues;
+      double seconds;
+   };
+
+   const char OP_LETTERS[] = "akcguisbemr";   // the timed commands
+
+   // A cursor over one line of the command file.
+   struct LineReader
+   {
+      const char* p;
+
+      void skipBlanks()
+      {
+         while (*p == ' ' || *p == '\t' || *p == '\r')
+            ++p;
+      }
+
+      bool atEnd()
+      {
+         skipBlanks();
+         return *p == '\n' || *p == '\0';
+      }
+
+      // reads a name; false if there is none
+      bool name(string& result)
+      {
+         skipBlanks();
+         const char* start = p;
+         while (*p != ' ' && *p != '\t' && *p != '\r' &&
+                *p != '\n' && *p != '\0')
+            ++p;
+         result.assign(start, p - start);
+         return p != start;
+      }
+
+      // reads an int; false if the next token is not one
+      bool integer(int& result)
+      {
+         skipBlanks();
+         char* end;
+         errno = 0;
+         long value = strtol(p, &end, 10);
+         if (end == p || errno != 0 || value != int(value) ||
+             (*end != ' ' && *end != '\t' && *end != '\r' &&
+              *end != '\n' && *end != '\0'))
+            return false;
+         p = end;
+         result = int(value);
+         return true;
+      }
+
+      void skipLine()
+      {
+         while (*p != '\n' && *p != '\0')
+            ++p;
+         if (*p == '\n')
+            ++p;
+      }
+   };
+
+   double seconds_since(batch_clock::time_point start)
+   {
+      return chrono::duration<double>(batch_clock::now() - start).count();
+   }
+}
+
+int run_batch(const char* text, ostream& out)
+{
+   map<string, IntSet> sets;
+   OpStats stats[128] = { };
+   vector<int> values;
+   string name1, name2;
+   int lineNum = 0, errors = 0;
+   long commands = 0;
+   bool quit = false;
+   batch_clock::time_point runStart = batch_clock::now();
+
+   LineReader line;
+   line.p = text;
+   while (*line.p != '\0' && !quit)
+   {
+      ++lineNum;
+      line.skipBlanks();
+      char op = *line.p;
+      if (op == '\n' || op == '\0' || op == '#')
+      {
+         line.skipLine();
+         continue;
+      }
+      ++line.p;
+
+      bool ok = true;
+      values.clear();
+      switch (op)
+      {
+      case 'a': case 'k': case 'c':
+         ok = line.name(name1);
+         while (ok && !line.atEnd())
+         {
+            int v;
+            ok = line.integer(v);
+            values.push_back(v);
+         }
+         break;
+      case 'g':
+         values.resize(3);
+         ok = line.name(name1) && line.integer(values[0]) &&
+              line.integer(values[1]) && line.integer(values[2]) &&
+              values[0] >= 0 && values[2] > 0;
+         break;
+      case 'u': case 'i': case 's': case 'b': case 'e':
+         ok = line.name(name1) && line.name(name2);
+         break;
+      case 'm': case 'r': case 'z': case 'd':
+         ok = line.name(name1);
+         break;
+      case 'q':
+         quit = true;
+         break;
+      default:
+         ok = false;
+      }
+      if (ok && !line.atEnd())
+         ok = false;
+      if (!ok)
+      {
+         cerr << "line " << lineNum << ": bad command" << endl;
+         ++errors;
+         line.skipLine();
+         continue;
+      }
+      line.skipLine();
+      if (quit)
+         break;
+
+      IntSet& is = sets[name1];
+      ++commands;
+      if (op == 'z' || op == 'd')
+      {
+         // output commands are not timed (the time would be the
+         // stream's, not the IntSet's)
+         out << "   " << name1;
+         if (op == 'z')
+            out << " has " << is.size() << " items";
+         else if (is.isEmpty())
+            out << ": (empty)";
+         else
+         {
+            out << ": ";
+            is.DumpData(out);
+         }
+         out << '\n';
+         continue;
+      }
+      IntSet& other = (op == 'u' || op == 'i' || op == 's' ||
+                       op == 'b' || op == 'e') ? sets[name2] : is;
+      OpStats& st = stats[int(op)];
+      long elements = 0, trues = 0;
+      batch_clock::time_point start = batch_clock::now();
+
+      switch (op)
+      {
+      case 'a':
+         for (size_t v = 0; v < values.size(); ++v)
+            trues += is.add(values[v]);
+         elements = long(values.size());
+         break;
+      case 'k':
+         for (size_t v = 0; v < values.size(); ++v)
+            trues += is.remove(values[v]);
+         elements = long(values.size());
+         break;
+      case 'c':
+         for (size_t v = 0; v < values.size(); ++v)
+            trues += is.contains(values[v]);
+         elements = long(values.size());
+         break;
+      case 'g':
+      {
+         unsigned seed = unsigned(values[1]);
+         is.reserve(is.size() + values[0]);
+         for (int n = 0; n < values[0]; ++n)
+         {
+            seed = seed * 1103515245u + 12345u;
+            trues += is.add(int((seed >> 1) % unsigned(values[2])));
+         }
+         elements = values[0];
+         break;
+      }
+      case 'u':
+         elements = is.size() + other.size();
+         is |= other;
+         break;
+      case 'i':
+         elements = is.size() + other.size();
+         is &= other;
+         break;
+      case 's':
+         elements = is.size() + other.size();
+         is -= other;
+         break;
+      case 'b':
+         elements = is.size() + other.size();
+         trues = is.isSubsetOf(other);
+         break;
+      case 'e':
+         elements = is.size() + other.size();
+         trues = (is == other);
+         break;
+      case 'm':
+         elements = 1;
+         trues = is.isEmpty();
+         break;
+      case 'r':
+         elements = is.size();
+         is.reset();
+         break;
+      }
+
+      st.seconds += seconds_since(start);
+      st.commands += 1;
+      st.elements += elements;
+      st.trues += trues;
+   }
+
+   double total = seconds_since(runStart);
+   double inOps = 0;
+   for (const char* op = OP_LETTERS; *op != '\0'; ++op)
+      inOps += stats[int(*op)].seconds;
+
+   out << "Batch summary: " << commands << " commands on " << sets.size()
+       << " IntSets, " << errors << " bad lines, " << fixed
+       << setprecision(3) << total * 1e3 << " ms in all ("
+       << inOps * 1e3 << " ms in IntSet operations)" << endl;
+   out << "   op  commands    elements    total ms  ns/element       true"
+       << endl;
+   for (const char* op = OP_LETTERS; *op != '\0'; ++op)
+   {
+      const OpStats& st = stats[int(*op)];
+      if (st.commands == 0)
+         continue;
+      out << "   " << *op << setw(10) << st.commands << setw(12) << st.elements
+          << setw(12) << setprecision(3) << st.seconds * 1e3
+          << setw(12) << setprecision(1)
+          << (st.elements > 0 ? st.seconds * 1e9 / st.elements : 0.0);
+      if (*op == 'c' || *op == 'b' || *op == 'e' || *op == 'm')
+         out << setw(11) << st.trues;
+      out << endl;
+   }
+   return errors;
+}
+
+int run_batch_file(const char* fileName, ostream& out)
+{
+   FILE* file = (fileName == 0) ? stdin : fopen(fileName, "rb");
+   if (file == 0)
+   {
+      cerr << "can't open " << fileName << endl;
+      return EXIT_FAILURE;
+   }
+
+   // read the whole file in one go
+   string text;
+   char buffer[65536];
+   size_t got;
+   while ((got = fread(buffer, 1, sizeof buffer, file)) > 0)
+      text.append(buffer, got);
+   if (file != stdin)
+      fclose(file);
+
+   return (run_batch(text.c_str(), out) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,60 @@
+// FILE: IntSetBatch.h - header file for the IntSet batch command engine
+// FUNCTIONS PROVIDED: a non-interactive driver for IntSet that runs a
+//                     whole file of commands on any number of named
+//                     IntSets and reports the time spent in each kind
+//                     of operation (used by "./a2 batch [file]")
+//
+// COMMAND FILE FORMAT
+//   One command per line; blank lines and lines starting with # are
+//   skipped. A name is any run of non-blank characters (an IntSet of
+//   that name is created, empty, the first time it is used); a value
+//   is an int.
+//     a S v1 v2 ...    add the values to S
+//     k S v1 v2 ...    remove the values from S
+//     c S v1 v2 ...    query whether each value is in S
+//     g S n seed range add n pseudo-random values (0 <= value < range,
+//                      from the given seed) to S
+//     u S T            S becomes the union of S and T        (S |= T)
+//     i S T            S becomes the intersection of S and T (S &= T)
+//     s S T            S becomes S with the elements of T removed
+//                      (S -= T)
+//     b S T            query whether S is a subset of T
+//     e S T            query whether S is equal to T
+//     m S              query whether S is empty
+//     r S              reset S (make it empty)
+//     z S              write the size of S
+//     d S              write the elements of S
+//     q                stop (also stops at the end of the file)
+//   Only z and d write anything while the commands run; the results of
+//   the queries (c, b, e, m) are counted instead (the # of true
+//   results for each kind of query is part of the summary).
+//
+// FUNCTIONS
+//   int run_batch(const char* text, std::ostream& out)
+//     Pre:  text is a null-terminated command file (see above).
+//     Post: The commands of text have been run, the output of the z
+//           and d commands and then a summary have been written to
+//           out, and the # of lines with errors (each reported on
+//           cerr, with its line #, and otherwise skipped) is returned.
+//           For each kind of command but z and d (which only write,
+//           and are not timed), the summary gives the # of commands,
+//           the # of elements processed (values for a, k, c and g; the
+//           sizes of both IntSets for u, i, s, b and e), the time spent
+//           in IntSet operations (not in parsing) and that time per
+//           element, and (for queries) the # of true results.
+//   int run_batch_file(const char* fileName, std::ostream& out)
+//     Pre:  fileName is the name of a command file, or null for
+//           standard input.
+//     Post: The whole file has been read in one go and run_batch run
+//           on it; EXIT_SUCCESS is returned if there were no errors,
+//           otherwise (or if the file can't be read) EXIT_FAILURE.
+
+#ifndef INT_SET_BATCH_H
+#define INT_SET_BATCH_H
+
+#include <iostream>
+
+int run_batch(const char* text, std::ostream& out);
+int run_batch_file(const char* fileName, std::ostream& out);
+
+#endif
@@ -0,0 +1,752 @@
+// FILE: IntSetBench.cpp
+//       A non-interactive benchmark program for the IntSet data type.
+//
+// USAGE: ./a2bench [n]
+//        where n is the # of elements in each of the large IntSets
+//        (default 1000000).
+
+#include "IntSet.h"
+#include "SetKernels.h"
+#include "IntSetViews.h"
+#include "FrozenIntSet.h"
+#include "PersistentIntSet.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <new>
+#include <utility>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+// Every dynamic allocation made by the program is counted, along with
+// the # of bytes requested (the default operator new[] calls operator
+// new).
+long allocations = 0;
+long allocatedBytes = 0;
+
+void* operator new(size_t size)
+{
+   ++allocations;
+   allocatedBytes += long(size);
+   void* p = malloc(size ? size : 1);
+   if (p == 0)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   free(p);
+}
+
+// PROTOTYPES for functions used by this benchmark program:
+
+double seconds_since(clock_t start);
+// Pre:  start was obtained from clock().
+// Post: The CPU time (in seconds) elapsed since start is returned.
+
+void report(const char label[], double secs, int reps, double bytes);
+// Pre:  reps > 0
+// Post: A line giving the time per repetition of the operation
+//       labelled by label and (if bytes > 0) the throughput for
+//       bytes bytes processed per repetition has been written to
+//       cout.
+
+void bench_sorted_ops(int n);
+// Pre:  n > 0
+// Post: unionWith, intersect and subtract of two sorted IntSets of n
+//       elements each have been timed and reported.
+
+void bench_membership(int n);
+// Pre:  n > 0
+// Post: add, contains and remove of n pseudo-random values (in no
+//       particular order) have been timed and reported.
+
+void bench_chained(int n);
+// Pre:  n > 0
+// Post: The # of allocations per set operation (and the time) for a
+//       union/intersect/subtract chain of IntSets of about n elements
+//       has been reported for lvalue operations, chained rvalue
+//       operations and compound assignments.
+
+void bench_capacity(int n);
+// Pre:  n > 0
+// Post: The # of allocations made while filling a reserved IntSet
+//       with n elements, and while removing 99% of them again (as the
+//       capacity shrinks), has been reported.
+
+void bench_bulk_load(int n);
+// Pre:  n > 0
+// Post: Loading n pseudo-random values (about 1 in 8 a duplicate)
+//       into an IntSet with the range constructor, and with one add
+//       per value, has been timed and reported along with the # of
+//       allocations made.
+
+void bench_tiny_sets(int n);
+// Pre:  n > 0
+// Post: Creating, filling, copying and destroying n IntSets of a few
+//       elements each has been timed and reported along with the # of
+//       allocations made (none while they fit inline).
+
+void bench_equality(int n);
+// Pre:  n > 1
+// Post: operator== on two equal IntSets of n elements (added in
+//       different orders) and on two that differ in one element has
+//       been timed and reported.
+
+void bench_views(int n);
+// Pre:  n > 0
+// Post: Counting the elements of a chained union/intersect/subtract
+//       through IntSet temporaries and through the lazy views of
+//       IntSetViews.h has been timed and reported along with the # of
+//       allocations made.
+
+void bench_snapshots(int n);
+// Pre:  n > 0
+// Post: Taking read-only copies of an IntSet of n elements, and copies
+//       that are then changed, has been timed and reported along with
+//       the # of allocations made (none for read-only copies, which
+//       share the source's storage).
+
+void bench_frozen(int n);
+// Pre:  n > 0
+// Post: The memory taken by an IntSet and by a FrozenIntSet of the same
+//       n elements (clustered, and spread over all ints), and the time
+//       for contains, intersect and a write/read round trip of each
+//       FrozenIntSet, have been reported.
+
+void bench_versions(int n);
+// Pre:  n > 0
+// Post: Keeping a series of versions of a set of n elements, each
+//       made from the one before by one add or remove, as IntSet
+//       copies and as PersistentIntSet versions, has been timed and
+//       the memory taken per version reported.
+
+void bench_arena();
+// Pre:  (none)
+// Post: Serving a series of requests, each of which makes a few
+//       short-lived IntSets of a few hundred elements (two filled with
+//       add, their union, intersection and difference, and a copy),
+//       with the IntSets' memory from new_delete_resource(), from a
+//       monotonic_arena per request and from a monotonic_arena per
+//       request over a buffer on the stack, has been timed and
+//       reported along with the # of allocations made per request.
+
+int serve_request(int r, memory_resource* resource);
+// Pre:  resource is not null.
+// Post: Request r (see bench_arena) has been served with its IntSets'
+//       memory from resource, and the total of their sizes returned.
+
+int main(int argc, char* argv[])
+{
+   int n = 1000000;
+   if (argc > 1)
+      n = atoi(argv[1]);
+   if (n < 1)
+      n = 1;
+
+   cout << "IntSet benchmark (set kernels: " << setKernelsName() << ")" << endl;
+   bench_sorted_ops(n);
+   bench_membership(n);
+   bench_chained(n);
+   bench_capacity(n);
+   bench_bulk_load(n);
+   bench_tiny_sets(n);
+   if (n > 1)
+      bench_equality(n);
+   bench_views(n);
+   bench_snapshots(n);
+   bench_frozen(n);
+   bench_versions(n);
+   bench_arena();
+   return EXIT_SUCCESS;
+}
+
+double seconds_since(clock_t start)
+{
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void report(const char label[], double secs, int reps, double bytes)
+{
+   double perRep = secs / reps;
+   cout << "   " << left << setw(28) << label << right
+        << fixed << setprecision(3) << setw(10) << perRep * 1e3 << " ms";
+   if (perRep > 0 && bytes > 0)
+      cout << setw(10) << setprecision(2) << bytes / perRep / 1e9 << " GB/s";
+   cout << endl;
+}
+
+void bench_sorted_ops(int n)
+{
+   // is1 holds multiples of 2, is2 multiples of 3: they share n / 3
+   // (or so) elements and both are in sorted form
+   IntSet is1(n), is2(n);
+   for (int i = 0; i < n; ++i)
+   {
+      is1.add(2 * i);
+      is2.add(3 * i);
+   }
+
+   const int REPS = 20;
+   double bytes = 2.0 * n * sizeof(int);
+   clock_t start;
+   int check = 0;
+
+   cout << "Sorted IntSets of " << n << " elements each:" << endl;
+
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      check += is1.intersect(is2).size();
+   report("intersect", seconds_since(start), REPS, bytes);
+
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      check += is1.subtract(is2).size();
+   report("subtract", seconds_since(start), REPS, bytes);
+
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      check += is1.unionWith(is2).size();
+   report("unionWith", seconds_since(start), REPS, bytes);
+
+   int common = (2 * (n - 1)) / 6 + 1;
+   int expected = REPS * (common + (n - common) + (2 * n - common));
+   if (check != expected)
+      cout << "   *** result sizes are wrong (" << check << " vs "
+           << expected << ")" << endl;
+}
+
+void bench_membership(int n)
+{
+   IntSet is;
+   unsigned seed = 12345u;
+   clock_t start;
+   int hits = 0;
+
+   cout << "Unsorted IntSet of " << n << " elements:" << endl;
+
+   start = clock();
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      is.add(int(seed));
+   }
+   report("add", seconds_since(start), 1, double(n) * sizeof(int));
+
+   seed = 12345u;
+   start = clock();
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      hits += is.contains(int(seed));
+   }
+   report("contains", seconds_since(start), 1, double(n) * sizeof(int));
+
+   seed = 12345u;
+   start = clock();
+   for (int i = 0; i < n; i += 2)
+   {
+      seed = seed * 1103515245u + 12345u;
+      is.remove(int(seed));
+      seed = seed * 1103515245u + 12345u;
+   }
+   report("remove (every other)", seconds_since(start), 1, double(n / 2) * sizeof(int));
+
+   if (hits != n || is.size() != n - (n + 1) / 2)
+      cout << "   *** membership results are wrong" << endl;
+}
+
+void bench_chained(int n)
+{
+   IntSet a, b, c, d;
+   unsigned seed = 777u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      int v = int(seed % unsigned(2 * n));
+      switch (i % 4)
+      {
+      case 0: a.add(v); break;
+      case 1: b.add(v); break;
+      case 2: c.add(v); break;
+      case 3: d.add(v);
+      }
+   }
+
+   const int REPS = 10;
+   const int OPS = 3 * REPS;
+   long before;
+   clock_t start;
+   int check[3] = { 0, 0, 0 };
+   IntSet r;
+
+   cout << "Chained union/intersect/subtract of unsorted IntSets of about "
+        << n / 4 << " elements:" << endl;
+
+   before = allocations;
+   start = clock();
+   for (int rep = 0; rep < REPS; ++rep)
+   {
+      r = a.unionWith(b);
+      r = r.intersect(c);
+      r = r.subtract(d);
+      check[0] += r.size();
+   }
+   report("r = r.op(x) (copies)", seconds_since(start), OPS, 0);
+   cout << "      allocations per operation: "
+        << double(allocations - before) / OPS << endl;
+
+   before = allocations;
+   start = clock();
+   for (int rep = 0; rep < REPS; ++rep)
+   {
+      r = a.unionWith(b).intersect(c).subtract(d);
+      check[1] += r.size();
+   }
+   report("a.op(b).op(c).op(d)", seconds_since(start), OPS, 0);
+   cout << "      allocations per operation: "
+        << double(allocations - before) / OPS << endl;
+
+   before = allocations;
+   start = clock();
+   for (int rep = 0; rep < REPS; ++rep)
+   {
+      r.reset();
+      r |= a;
+      r |= b;
+      r &= c;
+      r -= d;
+      check[2] += r.size();
+   }
+   report("r |= b; r &= c; r -= d", seconds_since(start), OPS, 0);
+   cout << "      allocations per operation: "
+        << double(allocations - before) / OPS << endl;
+
+   if (check[0] != check[1] || check[1] != check[2])
+      cout << "   *** chained results are wrong" << endl;
+}
+
+void bench_capacity(int n)
+{
+   IntSet is;
+   long before = allocations;
+   clock_t start = clock();
+
+   cout << "Capacity management for " << n << " elements:" << endl;
+
+   is.reserve(n);
+   for (int i = 0; i < n; ++i)
+      is.add(i * 7);
+   report("reserve + add", seconds_since(start), 1, 0);
+   cout << "      allocations: " << allocations - before << endl;
+
+   before = allocations;
+   start = clock();
+   for (int i = 0; i < n; ++i)
+      if (i % 100 != 0)
+         is.remove(i * 7);
+   report("remove 99%", seconds_since(start), 1, 0);
+   cout << "      allocations (shrinking): " << allocations - before << endl;
+
+   if (is.size() != (n + 99) / 100)
+      cout << "   *** capacity results are wrong" << endl;
+}
+
+void bench_bulk_load(int n)
+{
+   int* values = new int[n];
+   unsigned seed = 4242u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      values[i] = int(seed % unsigned(n + n / 8 + 1)) - n / 2;
+   }
+
+   long before;
+   clock_t start;
+
+   cout << "Bulk load of " << n << " values:" << endl;
+
+   before = allocations;
+   start = clock();
+   IntSet bulk(values, values + n);
+   report("IntSet(first, last)", seconds_since(start), 1, double(n) * sizeof(int));
+   cout << "      allocations: " << allocations - before << endl;
+
+   before = allocations;
+   start = clock();
+   IntSet single;
+   for (int i = 0; i < n; ++i)
+      single.add(values[i]);
+   report("add one at a time", seconds_since(start), 1, double(n) * sizeof(int));
+   cout << "      allocations: " << allocations - before << endl;
+
+   if (!(bulk == single))
+      cout << "   *** bulk load results are wrong" << endl;
+   delete [] values;
+}
+
+void bench_tiny_sets(int n)
+{
+   const int SIZES[] = { 2, 8, 16 };
+   long before;
+   clock_t start;
+   int check = 0;
+
+   cout << "Create, fill and destroy " << n << " tiny IntSets:" << endl;
+
+   for (int s = 0; s < 3; ++s)
+   {
+      before = allocations;
+      start = clock();
+      for (int i = 0; i < n; ++i)
+      {
+         IntSet tiny;
+         for (int v = 0; v < SIZES[s]; ++v)
+            tiny.add(i + v);
+         IntSet copy(tiny);
+         copy.remove(i);
+         check += copy.size();
+      }
+      char label[32];
+      sprintf(label, "%d elements", SIZES[s]);
+      report(label, seconds_since(start), 1, 0);
+      cout << "      allocations: " << allocations - before << endl;
+      check -= n * (SIZES[s] - 1);
+   }
+
+   if (check != 0)
+      cout << "   *** tiny set results are wrong" << endl;
+}
+
+void bench_equality(int n)
+{
+   IntSet a, same, differ;
+   unsigned seed = 31337u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      a.add(int(seed));
+   }
+   // same holds the elements of a in reverse order; differ is a with
+   // one element replaced
+   seed = 31337u;
+   int* values = new int[n];
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      values[i] = int(seed);
+   }
+   for (int i = n - 1; i >= 0; --i)
+      same.add(values[i]);
+   differ = a;
+   differ.remove(values[n / 2]);
+   differ.add(values[n / 2] ^ 1);
+   delete [] values;
+
+   const int REPS = 1000;
+   clock_t start;
+   int equal = 0;
+
+   cout << "Equality of unsorted IntSets of " << n << " elements:" << endl;
+
+   start = clock();
+   for (int r = 0; r < 10; ++r)
+      equal += (a == same);
+   report("equal sets", seconds_since(start), 10, double(n) * sizeof(int));
+
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      equal += (a == differ);
+   report("one element differs", seconds_since(start), REPS, 0);
+
+   if (equal != 10)
+      cout << "   *** equality results are wrong" << endl;
+}
+
+void bench_views(int n)
+{
+   IntSet a, b, c;
+   unsigned seed = 2468u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      a.add(int(seed % unsigned(2 * n)));
+      seed = seed * 1103515245u + 12345u;
+      b.add(int(seed % unsigned(2 * n)));
+      seed = seed * 1103515245u + 12345u;
+      c.add(int(seed % unsigned(2 * n)));
+   }
+
+   const int REPS = 5;
+   long before;
+   clock_t start;
+   long counted[2] = { 0, 0 };
+
+   cout << "Counting (a | b) & c - a for unsorted IntSets of " << n
+        << " elements:" << endl;
+
+   before = allocations;
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      counted[0] += a.unionWith(b).intersect(c).subtract(a).size();
+   report("IntSet temporaries", seconds_since(start), REPS, 0);
+   cout << "      allocations: " << allocations - before << endl;
+
+   before = allocations;
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+      counted[1] += subtract_view(intersect_view(union_view(a, b), c), a).size();
+   report("lazy views", seconds_since(start), REPS, 0);
+   cout << "      allocations: " << allocations - before << endl;
+
+   if (counted[0] != counted[1])
+      cout << "   *** view results are wrong" << endl;
+}
+
+void bench_snapshots(int n)
+{
+   IntSet source;
+   unsigned seed = 4242u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      source.add(int(seed));
+   }
+   int probe = int(seed);     // the newest element
+
+   const int REPS = 1000;
+   long before;
+   clock_t start;
+   int check = 0;
+
+   cout << "Copies of an IntSet of " << source.size() << " elements:"
+        << endl;
+
+   before = allocations;
+   start = clock();
+   for (int r = 0; r < REPS; ++r)
+   {
+      IntSet snapshot(source);
+      check += snapshot.contains(probe);
+   }
+   report("read-only copy", seconds_since(start), REPS, 0);
+   cout << "      allocations: " << allocations - before << endl;
+
+   const int WRITE_REPS = 10;
+   before = allocations;
+   start = clock();
+   for (int r = 0; r < WRITE_REPS; ++r)
+   {
+      IntSet snapshot(source);
+      check += snapshot.remove(probe);
+   }
+   report("copy, then remove", seconds_since(start), WRITE_REPS, 0);
+   cout << "      allocations: " << allocations - before << endl;
+
+   if (check != REPS + WRITE_REPS || !source.contains(probe))
+      cout << "   *** snapshot results are wrong" << endl;
+}
+
+void bench_frozen(int n)
+{
+   // clustered: runs of 64 values at most 4 apart, the runs 1000 apart;
+   // spread: pseudo-random values over all ints
+   int* clustered = new int[n];
+   int* spread = new int[n];
+   unsigned seed = 777u;
+   int value = 0;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      value += (i % 64 == 0) ? 1000 : 1 + int((seed >> 8) % 4);
+      clustered[i] = value;
+      seed = seed * 1103515245u + 12345u;
+      spread[i] = int(seed);
+   }
+
+   const int* SOURCES[] = { clustered, spread };
+   const char* NAMES[] = { "clustered", "spread" };
+   const int PROBES = 1000000;
+   clock_t start;
+   long check = 0;
+
+   for (int k = 0; k < 2; ++k)
+   {
+      long before = allocatedBytes;
+      IntSet is(SOURCES[k], SOURCES[k] + n);
+      long intSetBytes = long(sizeof(IntSet)) + allocatedBytes - before;
+      FrozenIntSet frozen(is);
+
+      cout << "FrozenIntSet of " << is.size() << " " << NAMES[k]
+           << " elements:" << endl;
+      cout << "   IntSet " << setprecision(2) << double(intSetBytes) / is.size()
+           << " bytes/element, FrozenIntSet "
+           << double(frozen.bytes()) / is.size() << " bytes/element ("
+           << setprecision(1) << double(intSetBytes) / frozen.bytes()
+           << "x smaller)" << endl;
+
+      start = clock();
+      for (int p = 0; p < PROBES; ++p)
+         check += is.contains(SOURCES[k][p % n] + (p & 1));
+      report("IntSet contains (1M)", seconds_since(start), 1, 0);
+      start = clock();
+      for (int p = 0; p < PROBES; ++p)
+         check -= frozen.contains(SOURCES[k][p % n] + (p & 1));
+      report("FrozenIntSet contains (1M)", seconds_since(start), 1, 0);
+
+      // the other half of the elements, as a second operand
+      IntSet half;
+      for (int i = 0; i < n; i += 2)
+         half.add(SOURCES[k][i]);
+      FrozenIntSet frozenHalf(half);
+      start = clock();
+      check += is.intersect(half).size();
+      report("IntSet intersect", seconds_since(start), 1, 0);
+      start = clock();
+      check -= frozen.intersect(frozenHalf).size();
+      report("FrozenIntSet intersect", seconds_since(start), 1, 0);
+
+      start = clock();
+      stringstream file;
+      frozen.write(file);
+      FrozenIntSet reread;
+      reread.read(file);
+      report("write + read", seconds_since(start), 1, 0);
+      cout << "      file size: " << file.str().size() << " bytes" << endl;
+      if (!(reread == frozen) || !(frozen.thaw() == is))
+         check = -1;
+   }
+
+   if (check != 0)
+      cout << "   *** frozen set results are wrong" << endl;
+   delete [] clustered;
+   delete [] spread;
+}
+
+void bench_versions(int n)
+{
+   int* values = new int[n];
+   unsigned seed = 1234u;
+   for (int i = 0; i < n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      values[i] = int(seed >> 1);
+   }
+   IntSet base(values, values + n);
+   PersistentIntSet persistentBase(base);
+
+   // version v adds a new value (v even) or removes an element (v odd)
+   const int INTSET_VERSIONS = 10, PERSISTENT_VERSIONS = 10000;
+   long before;
+   clock_t start;
+   int check = 0;
+
+   cout << "Versions of a set of " << base.size() << " elements:" << endl;
+
+   vector<IntSet> copies;
+   copies.reserve(INTSET_VERSIONS + 1);
+   copies.push_back(base);
+   before = allocatedBytes;
+   start = clock();
+   for (int v = 0; v < INTSET_VERSIONS; ++v)
+   {
+      copies.push_back(copies.back());
+      if (v % 2 == 0)
+         copies.back().add(-1 - v);
+      else
+         copies.back().remove(values[v]);
+   }
+   report("IntSet copy + change", seconds_since(start), INTSET_VERSIONS, 0);
+   cout << "      bytes per version: "
+        << (allocatedBytes - before) / INTSET_VERSIONS << endl;
+
+   vector<PersistentIntSet> versions;
+   versions.reserve(PERSISTENT_VERSIONS + 1);
+   versions.push_back(persistentBase);
+   before = allocatedBytes;
+   start = clock();
+   for (int v = 0; v < PERSISTENT_VERSIONS; ++v)
+   {
+      if (v % 2 == 0)
+         versions.push_back(versions.back().add(-1 - v));
+      else
+         versions.push_back(versions.back().remove(values[v % n]));
+   }
+   report("PersistentIntSet add/remove", seconds_since(start),
+          PERSISTENT_VERSIONS, 0);
+   cout << "      bytes per version: "
+        << (allocatedBytes - before) / PERSISTENT_VERSIONS << endl;
+
+   // every version is still intact
+   for (int v = 0; v < INTSET_VERSIONS; ++v)
+      check += (copies[v + 1].size() == versions[v + 1].size()) &&
+               (copies[v].contains(-1 - v) == versions[v].contains(-1 - v));
+   if (check != INTSET_VERSIONS || !(versions[0] == persistentBase) ||
+       !(versions[INTSET_VERSIONS].toIntSet() == copies[INTSET_VERSIONS]))
+      cout << "   *** version results are wrong" << endl;
+   delete [] values;
+}
+
+void bench_arena()
+{
+   const int REQUESTS = 10000;
+   const size_t BUFFER_SIZE = 65536;
+   const char* LABELS[] = { "new/delete", "arena", "arena on stack" };
+   long before;
+   clock_t start;
+   long check = 0;
+
+   cout << "Requests of short-lived IntSets (" << REQUESTS
+        << " requests):" << endl;
+
+   for (int way = 0; way < 3; ++way)
+   {
+      before = allocations;
+      start = clock();
+      for (int r = 0; r < REQUESTS; ++r)
+      {
+         if (way == 0)
+            check += serve_request(r, new_delete_resource());
+         else if (way == 1)
+         {
+            monotonic_arena arena;
+            check += serve_request(r, &arena);
+         }
+         else
+         {
+            char buffer[BUFFER_SIZE];
+            monotonic_arena arena(buffer, BUFFER_SIZE);
+            check += serve_request(r, &arena);
+         }
+      }
+      report(LABELS[way], seconds_since(start), REQUESTS, 0);
+      cout << "      allocations per request: " << fixed
+           << setprecision(1) << double(allocations - before) / REQUESTS
+           << endl;
+   }
+
+   if (check != 3L * REQUESTS * 865)
+      cout << "   *** request results are wrong" << endl;
+}
+
+int serve_request(int r, memory_resource* resource)
+{
+   const int VALUES = 200;
+   IntSet odds(0, resource), threes(0, resource);
+   for (int v = 0; v < VALUES; ++v)
+   {
+      odds.add(r + 2 * v + 1);
+      threes.add(r + 3 * v);
+   }
+   IntSet either = odds.unionWith(threes);
+   IntSet both = odds.intersect(threes);
+   IntSet onlyOdds = odds.subtract(threes);
+   IntSet copy(either, resource);
+   copy.remove(r);
+   return either.size() + both.size() + onlyOdds.size() + copy.size();
+}
@@ -0,0 +1,571 @@
+// FILE: IntSetFuzz.cpp
+//       A randomised differential test and benchmark program for the
+//       IntSet backends of this directory: one random sequence of
+//       operations on a few sets is run on every backend, and each
+//       backend is checked against std::set<int> (the oracle) and
+//       timed.
+//
+// USAGE: ./a2fuzz [ops [range [seed]]]
+//        where ops is the # of operations (default 200000), range is
+//        the # of distinct values used (0 .. range - 1, default 1000)
+//        and seed seeds the random sequence (default 1).
+//
+// For each backend the sequence is run twice:
+//   1. checked: after every operation the result (returned value, or
+//      the set it produced) is compared with the oracle; the first
+//      mismatch is reported and ends the run for that backend;
+//   2. timed: the sequence is run again with no checking, and the
+//      operations per second (and a checksum of all the results, which
+//      has to match the oracle's) are reported.
+//
+// BACKENDS
+//   IntSet, IntSet through the lazy views (IntSetViews.h), IntSet
+//   through ParallelSetOps (4 threads), IntSet through FrozenIntSet
+//   (FrozenIntSet.h), PersistentIntSet (PersistentIntSet.h, through
+//   VersionedSet below), and Set<int, Storage> for each storage policy
+//   of Set.h (FixedSet<int, 1024> only when range is at most 1024).
+//   A new backend needs a line in main (and, if its set operations
+//   are spelled differently, an operations class like ViewOps below).
+//   The sets of the random sequence stay far smaller than
+//   ParallelSetOps::PARALLEL_MIN_SIZE, so that backend only runs the
+//   fallback to the IntSet member functions; the parallel check below
+//   covers its threaded path.
+// SHRINK CHECK
+//   Before the backends run, IntSets reserved at each capacity from
+//   INLINE_CAPACITY + 1 to 8 * INLINE_CAPACITY (so across the
+//   shrink floor) are filled and then emptied one remove at a time.
+//   After every remove the elements are checked against the oracle,
+//   and a counting memory_resource checks that the set still holds
+//   its buffer: remove never moves the elements back inline (only
+//   shrink_to_fit does, which is checked last).
+// PARALLEL CHECK
+//   Also before the backends run, pairs of IntSets of
+//   PARALLEL_MIN_SIZE elements each (the even and the multiples of 3
+//   values) are built in four shapes: both added in ascending order
+//   (so the sorted-form split runs), both added in a random order,
+//   one of each, and both ascending with some elements then removed
+//   (so the live entries are checked). Every ParallelSetOps operation
+//   is run on each pair, both ways round, with 2, 3, 4 and 8 threads.
+//   The result is checked against the oracle, must hold its elements
+//   in the order the IntSet member function gives them, and may only
+//   be marked sorted if its elements really are in ascending order.
+// NOTE: The IntSet of PR1 is not a backend: it has the same class name
+//       as this IntSet (so the two can't be linked into one program)
+//       and holds at most 10 elements.
+
+#include "IntSet.h"
+#include "IntSetViews.h"
+#include "ParallelSetOps.h"
+#include "FrozenIntSet.h"
+#include "PersistentIntSet.h"
+#include "Set.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <set>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+const int NUM_SETS = 4;
+
+struct Op
+{
+   char kind;    // a(dd) k (remove) c(ontains) u i s (set operations)
+                 // b (subset) e (equal) y (copy) r(eset)
+   int  x, y;    // the set(s) operated on (y: the second operand)
+   int  value;   // the value for a, k and c
+};
+
+// The set operations of a backend, spelled as member functions.
+struct MemberOps
+{
+   template <class S>
+   static S unite(const S& a, const S& b) { return a.unionWith(b); }
+   template <class S>
+   static S intersect(const S& a, const S& b) { return a.intersect(b); }
+   template <class S>
+   static S subtract(const S& a, const S& b) { return a.subtract(b); }
+};
+
+// The set operations of IntSet, through the lazy views.
+struct ViewOps
+{
+   static IntSet unite(const IntSet& a, const IntSet& b)
+   { return to_intset(union_view(a, b)); }
+   static IntSet intersect(const IntSet& a, const IntSet& b)
+   { return to_intset(intersect_view(a, b)); }
+   static IntSet subtract(const IntSet& a, const IntSet& b)
+   { return to_intset(subtract_view(a, b)); }
+};
+
+// The set operations of IntSet, through ParallelSetOps.
+struct ParallelOps
+{
+   static IntSet unite(const IntSet& a, const IntSet& b)
+   { return ParallelSetOps::unionWith(a, b, 4); }
+   static IntSet intersect(const IntSet& a, const IntSet& b)
+   { return ParallelSetOps::intersect(a, b, 4); }
+   static IntSet subtract(const IntSet& a, const IntSet& b)
+   { return ParallelSetOps::subtract(a, b, 4); }
+};
+
+// The set operations of IntSet, through FrozenIntSet (each operand is
+// frozen, the operation streamed and the result thawed).
+struct FrozenOps
+{
+   static IntSet unite(const IntSet& a, const IntSet& b)
+   { return FrozenIntSet(a).unionWith(FrozenIntSet(b)).thaw(); }
+   static IntSet intersect(const IntSet& a, const IntSet& b)
+   { return FrozenIntSet(a).intersect(FrozenIntSet(b)).thaw(); }
+   static IntSet subtract(const IntSet& a, const IntSet& b)
+   { return FrozenIntSet(a).subtract(FrozenIntSet(b)).thaw(); }
+};
+
+// PersistentIntSet as a backend: each change makes a new version,
+// which replaces the current one (the set operations add or drop one
+// element at a time).
+class VersionedSet
+{
+public:
+   int size() const { return version.size(); }
+   bool contains(int anInt) const { return version.contains(anInt); }
+   bool isSubsetOf(const VersionedSet& other) const
+   { return version.isSubsetOf(other.version); }
+   bool add(int anInt)
+   {
+      int before = version.size();
+      version = version.add(anInt);
+      return version.size() != before;
+   }
+   bool remove(int anInt)
+   {
+      int before = version.size();
+      version = version.remove(anInt);
+      return version.size() != before;
+   }
+   void reset() { version = PersistentIntSet(); }
+   VersionedSet unionWith(const VersionedSet& other) const
+   {
+      VersionedSet result(*this);
+      for (int x : other.version)
+         result.add(x);
+      return result;
+   }
+   VersionedSet intersect(const VersionedSet& other) const
+   {
+      VersionedSet result(*this);
+      for (int x : version)
+         if (!other.contains(x))
+            result.remove(x);
+      return result;
+   }
+   VersionedSet subtract(const VersionedSet& other) const
+   {
+      VersionedSet result(*this);
+      for (int x : other.version)
+         result.remove(x);
+      return result;
+   }
+   bool operator==(const VersionedSet& other) const
+   { return version == other.version; }
+private:
+   PersistentIntSet version;
+};
+
+// A memory_resource that counts the buffers it has handed out and not
+// had back, so a check can see whether an IntSet holds a buffer or
+// keeps its elements inline.
+class CountingResource : public memory_resource
+{
+public:
+   int live = 0;
+private:
+   void* do_allocate(size_t bytes, size_t alignment) override
+   {
+      ++live;
+      return new_delete_resource()->allocate(bytes, alignment);
+   }
+   void do_deallocate(void* p, size_t bytes, size_t alignment) override
+   {
+      --live;
+      new_delete_resource()->deallocate(p, bytes, alignment);
+   }
+};
+
+// PROTOTYPES for functions used by this program:
+
+vector<Op> make_ops(int count, int range, unsigned seed);
+// Pre:  count >= 0, range > 0
+// Post: A pseudo-random sequence of count operations on NUM_SETS sets
+//       with values in 0 .. range - 1 is returned.
+
+long oracle_op(const Op& op, set<int>* s);
+// Pre:  s is an array of NUM_SETS sets.
+// Post: op has been run on s and its contribution to the checksum (the
+//       value returned, or the size of the set produced) is returned.
+
+long run_oracle(const vector<Op>& ops);
+// Pre:  (none)
+// Post: ops has been run on NUM_SETS std::set<int>'s and the checksum
+//       of the results is returned.
+
+bool check_shrink();
+// Pre:  (none)
+// Post: The shrink check (see SHRINK CHECK above) has been run, a line
+//       of results written to cout and true returned if it passed
+//       (otherwise the first failure has been reported and false is
+//       returned).
+
+bool check_parallel();
+// Pre:  (none)
+// Post: The parallel check (see PARALLEL CHECK above) has been run, a
+//       line of results written to cout and true returned if it passed
+//       (otherwise the first failure has been reported and false is
+//       returned).
+
+template <class S, class SetOps>
+bool run_backend(const char name[], const vector<Op>& ops, long checksum);
+// Pre:  checksum is run_oracle(ops).
+// Post: ops has been run (checked, then timed) on backend S with set
+//       operations SetOps, a line of results has been written to cout
+//       and true is returned if the backend agreed with the oracle
+//       throughout (otherwise the first mismatch has been reported and
+//       false is returned).
+
+template <class S>
+bool same_as(const S& s, const set<int>& oracle);
+// Pre:  (none)
+// Post: True is returned if s has exactly the elements of oracle.
+
+int main(int argc, char* argv[])
+{
+   int count = 200000, range = 1000;
+   unsigned seed = 1u;
+   if (argc > 1)
+      count = atoi(argv[1]);
+   if (argc > 2)
+      range = atoi(argv[2]);
+   if (argc > 3)
+      seed = unsigned(atoi(argv[3]));
+   if (count < 0)
+      count = 0;
+   if (range < 1)
+      range = 1;
+
+   vector<Op> ops = make_ops(count, range, seed);
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   long checksum = run_oracle(ops);
+   double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   cout << count << " operations on " << NUM_SETS << " sets, values 0.."
+        << range - 1 << ", seed " << seed << endl;
+   cout << "   " << left << setw(26) << "std::set<int> (oracle)" << right
+        << fixed << setprecision(0) << setw(14)
+        << (secs > 0 ? count / secs : 0.0) << " ops/s" << endl;
+
+   bool ok = check_shrink();
+   ok &= check_parallel();
+   ok &= run_backend<IntSet, MemberOps>("IntSet", ops, checksum);
+   ok &= run_backend<IntSet, ViewOps>("IntSet (views)", ops, checksum);
+   ok &= run_backend<IntSet, ParallelOps>("IntSet (ParallelSetOps)", ops, checksum);
+   ok &= run_backend<IntSet, FrozenOps>("IntSet (FrozenIntSet)", ops, checksum);
+   ok &= run_backend<VersionedSet, MemberOps>("PersistentIntSet", ops, checksum);
+   if (range <= 1024)
+      ok &= run_backend<FixedSet<int, 1024>, MemberOps>("FixedSet<int, 1024>", ops, checksum);
+   ok &= run_backend<DynamicSet<int>, MemberOps>("DynamicSet<int>", ops, checksum);
+   ok &= run_backend<SortedSet<int>, MemberOps>("SortedSet<int>", ops, checksum);
+   ok &= run_backend<HashedSet<int>, MemberOps>("HashedSet<int>", ops, checksum);
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+vector<Op> make_ops(int count, int range, unsigned seed)
+{
+   // out of every 100 operations (on average)
+   const char KINDS[] = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"   // 30 add
+                        "kkkkkkkkkkkkkkkkkkkk"             // 20 remove
+                        "cccccccccccccccccccc"             // 20 contains
+                        "uuuuiiiisssss"                    // 13 set ops
+                        "bbbbeeeeyyyyy"                    // 13 queries, copy
+                        "rrrr";                            //  4 reset
+   const int NUM_KINDS = sizeof(KINDS) - 1;
+
+   vector<Op> ops(count);
+   for (int k = 0; k < count; ++k)
+   {
+      seed = seed * 1103515245u + 12345u;
+      ops[k].kind = KINDS[(seed >> 8) % NUM_KINDS];
+      seed = seed * 1103515245u + 12345u;
+      ops[k].x = (seed >> 8) % NUM_SETS;
+      seed = seed * 1103515245u + 12345u;
+      ops[k].y = (seed >> 8) % NUM_SETS;
+      seed = seed * 1103515245u + 12345u;
+      ops[k].value = int((seed >> 4) % unsigned(range));
+   }
+   return ops;
+}
+
+long oracle_op(const Op& op, set<int>* s)
+{
+   set<int>& x = s[op.x];
+   const set<int>& y = s[op.y];
+   switch (op.kind)
+   {
+   case 'a':
+      return x.insert(op.value).second;
+   case 'k':
+      return long(x.erase(op.value));
+   case 'c':
+      return long(x.count(op.value));
+   case 'u':
+   {
+      set<int> result = x;
+      result.insert(y.begin(), y.end());
+      x = result;
+      return long(x.size());
+   }
+   case 'i': case 's':
+   {
+      set<int> result;
+      for (set<int>::const_iterator it = x.begin(); it != x.end(); ++it)
+         if ((y.count(*it) == 1) == (op.kind == 'i'))
+            result.insert(*it);
+      x = result;
+      return long(x.size());
+   }
+   case 'b':
+      for (set<int>::const_iterator it = x.begin(); it != x.end(); ++it)
+         if (y.count(*it) == 0)
+            return 0;
+      return 1;
+   case 'e':
+      return x == y;
+   case 'y':
+      x = y;
+      return 0;
+   case 'r':
+      x.clear();
+   }
+   return 0;
+}
+
+bool check_shrink()
+{
+   cout << "   " << left << setw(26) << "IntSet (shrink check)" << right;
+   for (int cap = IntSet::INLINE_CAPACITY + 1;
+        cap <= 8 * IntSet::INLINE_CAPACITY; ++cap)
+   {
+      CountingResource counter;
+      {
+         IntSet s(0, &counter);
+         set<int> oracle;
+         s.reserve(cap);
+         for (int v = 0; v < cap; ++v)
+         {
+            s.add(v);
+            oracle.insert(v);
+         }
+         // remove from both ends towards the middle
+         for (int k = 0; k < cap; ++k)
+         {
+            int v = (k % 2 == 0) ? k / 2 : cap - 1 - k / 2;
+            s.remove(v);
+            oracle.erase(v);
+            if (!same_as(s, oracle) || counter.live != 1)
+            {
+               cout << "   *** FAILED at capacity " << cap << " after "
+                    << k + 1 << " removes (" << counter.live
+                    << " buffers held)" << endl;
+               return false;
+            }
+         }
+         s.shrink_to_fit();
+         if (counter.live != 0)
+         {
+            cout << "   *** FAILED at capacity " << cap
+                 << ": shrink_to_fit kept a buffer" << endl;
+            return false;
+         }
+      }
+   }
+   cout << setw(14) << "" << "         ok" << endl;
+   return true;
+}
+
+// Returns 0, step, 2 * step, ..., (count - 1) * step, in ascending
+// order or (if shuffled) in a pseudo-random order.
+vector<int> multiples(int count, int step, bool shuffled)
+{
+   vector<int> values(count);
+   for (int k = 0; k < count; ++k)
+      values[k] = k * step;
+   unsigned seed = unsigned(step);
+   for (int k = count - 1; shuffled && k > 0; --k)
+   {
+      seed = seed * 1103515245u + 12345u;
+      swap(values[k], values[(seed >> 8) % unsigned(k + 1)]);
+   }
+   return values;
+}
+
+// Adds values (in order) to s and to oracle, then removes every
+// removeEvery'th of them again (none if removeEvery is 0).
+void fill_large(IntSet& s, set<int>& oracle, const vector<int>& values,
+                int removeEvery)
+{
+   for (size_t k = 0; k < values.size(); ++k)
+   {
+      s.add(values[k]);
+      oracle.insert(values[k]);
+   }
+   for (size_t k = 0; removeEvery > 0 && k < values.size(); k += removeEvery)
+   {
+      s.remove(values[k]);
+      oracle.erase(values[k]);
+   }
+}
+
+bool check_parallel()
+{
+   const int N = ParallelSetOps::PARALLEL_MIN_SIZE;
+   const char* SHAPES[] = { "sorted", "unsorted", "mixed", "removed" };
+   const int THREADS[] = { 2, 3, 4, 8 };
+
+   cout << "   " << left << setw(26) << "IntSet (parallel, large)" << right;
+   for (int shape = 0; shape < 4; ++shape)
+   {
+      IntSet s[2];
+      set<int> oracle[2];
+      fill_large(s[0], oracle[0], multiples(N, 2, shape == 1),
+                 shape == 3 ? 7 : 0);
+      fill_large(s[1], oracle[1], multiples(N, 3, shape == 1 || shape == 2),
+                 shape == 3 ? 5 : 0);
+      if (s[0].size() + s[1].size() < N)
+      {
+         cout << "   *** FAILED: " << SHAPES[shape]
+              << " sets too small to run in parallel" << endl;
+         return false;
+      }
+
+      for (int x = 0; x < 2; ++x)
+      {
+         for (const char* kind = "uis"; *kind != '\0'; ++kind)
+         {
+            Op op = { *kind, x, 1 - x, 0 };
+            set<int> expected[2] = { oracle[0], oracle[1] };
+            oracle_op(op, expected);
+            const IntSet &a = s[x], &b = s[1 - x];
+            IntSet member = (op.kind == 'u') ? a.unionWith(b)
+                          : (op.kind == 'i') ? a.intersect(b)
+                          : a.subtract(b);
+            for (int t = 0; t < 4; ++t)
+            {
+               int n = THREADS[t];
+               IntSet got =
+                  (op.kind == 'u') ? ParallelSetOps::unionWith(a, b, n)
+                : (op.kind == 'i') ? ParallelSetOps::intersect(a, b, n)
+                : ParallelSetOps::subtract(a, b, n);
+               if (!same_as(got, expected[x]) ||
+                   !equal(got.begin(), got.end(), member.begin()) ||
+                   (got.isSorted() && !is_sorted(got.begin(), got.end())))
+               {
+                  cout << "   *** FAILED: '" << op.kind << "' on the "
+                       << SHAPES[shape] << " sets " << x << " and " << 1 - x
+                       << " with " << THREADS[t] << " threads" << endl;
+                  return false;
+               }
+            }
+         }
+      }
+   }
+   cout << setw(14) << "" << "         ok" << endl;
+   return true;
+}
+
+long run_oracle(const vector<Op>& ops)
+{
+   set<int> s[NUM_SETS];
+   long checksum = 0;
+   for (size_t k = 0; k < ops.size(); ++k)
+      checksum += oracle_op(ops[k], s);
+   return checksum;
+}
+
+template <class S>
+bool same_as(const S& s, const set<int>& oracle)
+{
+   if (s.size() != int(oracle.size()))
+      return false;
+   for (set<int>::const_iterator it = oracle.begin(); it != oracle.end(); ++it)
+      if (!s.contains(*it))
+         return false;
+   return true;
+}
+
+// Runs ops[k] on s and returns its contribution to the checksum.
+template <class S, class SetOps>
+long run_op(const Op& op, S* s)
+{
+   S& x = s[op.x];
+   const S& y = s[op.y];
+   switch (op.kind)
+   {
+   case 'a': return x.add(op.value);
+   case 'k': return x.remove(op.value);
+   case 'c': return x.contains(op.value);
+   case 'u': x = SetOps::unite(x, y);     return x.size();
+   case 'i': x = SetOps::intersect(x, y); return x.size();
+   case 's': x = SetOps::subtract(x, y);  return x.size();
+   case 'b': return x.isSubsetOf(y);
+   case 'e': return x == y;
+   case 'y': x = y; return 0;
+   case 'r': x.reset(); return 0;
+   }
+   return 0;
+}
+
+template <class S, class SetOps>
+bool run_backend(const char name[], const vector<Op>& ops, long checksum)
+{
+   cout << "   " << left << setw(26) << name << right;
+
+   // 1. checked
+   {
+      S s[NUM_SETS];
+      set<int> oracle[NUM_SETS];
+      for (size_t k = 0; k < ops.size(); ++k)
+      {
+         const Op& op = ops[k];
+         long got = run_op<S, SetOps>(op, s);
+         long expected = oracle_op(op, oracle);
+         if (got != expected || !same_as(s[op.x], oracle[op.x]))
+         {
+            cout << "   *** FAILED at operation " << k << " ('" << op.kind
+                 << "' on set " << op.x << ", set " << op.y << ", value "
+                 << op.value << ")" << endl;
+            return false;
+         }
+      }
+   }
+
+   // 2. timed
+   S s[NUM_SETS];
+   long sum = 0;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (size_t k = 0; k < ops.size(); ++k)
+      sum += run_op<S, SetOps>(ops[k], s);
+   double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   cout << fixed << setprecision(0) << setw(14)
+        << (secs > 0 ? ops.size() / secs : 0.0) << " ops/s";
+   if (sum != checksum)
+   {
+      cout << "   *** checksum " << sum << " (oracle " << checksum << ")" << endl;
+      return false;
+   }
+   cout << "   ok" << endl;
+   return true;
+}
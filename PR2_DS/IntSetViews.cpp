@@ -0,0 +1,293 @@
+// FILE: IntSetViews.cpp
+//       Implementation file for the lazy IntSet set-operation views
+//       (See IntSetViews.h for documentation.)
+//       This file is included by IntSetViews.h and is not compiled on
+//       its own.
+//
+// A view only ever holds its two operands; all of the work is done by
+// its iterators:
+//   FilterIterator<A, B, keepIfIn> walks A and stops only at elements
+//   x with B.contains(x) == keepIfIn (intersect: true, subtract:
+//   false). It always rests on such an element or on A's end.
+//   UnionIterator<A, B> walks A to its end and then walks B through a
+//   FilterIterator<B, A, false> (the elements of B not in A).
+
+////////////////////////////////////////////////////////////////////
+// FilterIterator<A, B, keepIfIn>
+
+template <class A, class B, bool keepIfIn>
+FilterIterator<A, B, keepIfIn>::FilterIterator() : other(0) { }
+
+template <class A, class B, bool keepIfIn>
+FilterIterator<A, B, keepIfIn>::FilterIterator(
+    typename A::const_iterator cur, typename A::const_iterator last,
+    const B* other)
+    : cur(cur), last(last), other(other)
+{
+    skipUnwanted();
+}
+
+template <class A, class B, bool keepIfIn>
+void FilterIterator<A, B, keepIfIn>::skipUnwanted()
+{
+    while (cur != last && other->contains(*cur) != keepIfIn)
+    {
+        ++cur;
+    }
+}
+
+template <class A, class B, bool keepIfIn>
+const int& FilterIterator<A, B, keepIfIn>::operator*() const
+{
+    return *cur;
+}
+
+template <class A, class B, bool keepIfIn>
+const int* FilterIterator<A, B, keepIfIn>::operator->() const
+{
+    return &*cur;
+}
+
+template <class A, class B, bool keepIfIn>
+FilterIterator<A, B, keepIfIn>& FilterIterator<A, B, keepIfIn>::operator++()
+{
+    ++cur;
+    skipUnwanted();
+    return *this;
+}
+
+template <class A, class B, bool keepIfIn>
+FilterIterator<A, B, keepIfIn> FilterIterator<A, B, keepIfIn>::operator++(int)
+{
+    FilterIterator before = *this;
+    ++*this;
+    return before;
+}
+
+template <class A, class B, bool keepIfIn>
+bool FilterIterator<A, B, keepIfIn>::operator==(const FilterIterator& rhs) const
+{
+    return cur == rhs.cur;
+}
+
+template <class A, class B, bool keepIfIn>
+bool FilterIterator<A, B, keepIfIn>::operator!=(const FilterIterator& rhs) const
+{
+    return !(cur == rhs.cur);
+}
+
+////////////////////////////////////////////////////////////////////
+// UnionIterator<A, B>
+
+template <class A, class B>
+UnionIterator<A, B>::UnionIterator() { }
+
+template <class A, class B>
+UnionIterator<A, B>::UnionIterator(typename A::const_iterator curA,
+                                   typename A::const_iterator lastA,
+                                   FilterIterator<B, A, false> curB)
+    : curA(curA), lastA(lastA), curB(curB) { }
+
+template <class A, class B>
+const int& UnionIterator<A, B>::operator*() const
+{
+    return (curA != lastA) ? *curA : *curB;
+}
+
+template <class A, class B>
+const int* UnionIterator<A, B>::operator->() const
+{
+    return &**this;
+}
+
+template <class A, class B>
+UnionIterator<A, B>& UnionIterator<A, B>::operator++()
+{
+    if (curA != lastA)
+    {
+        ++curA;
+    }
+    else
+    {
+        ++curB;
+    }
+    return *this;
+}
+
+template <class A, class B>
+UnionIterator<A, B> UnionIterator<A, B>::operator++(int)
+{
+    UnionIterator before = *this;
+    ++*this;
+    return before;
+}
+
+template <class A, class B>
+bool UnionIterator<A, B>::operator==(const UnionIterator& rhs) const
+{
+    return curA == rhs.curA && curB == rhs.curB;
+}
+
+template <class A, class B>
+bool UnionIterator<A, B>::operator!=(const UnionIterator& rhs) const
+{
+    return !(*this == rhs);
+}
+
+////////////////////////////////////////////////////////////////////
+// UnionView<A, B>
+
+template <class A, class B>
+UnionView<A, B>::UnionView(const A& a, const B& b) : a(a), b(b) { }
+
+template <class A, class B>
+typename UnionView<A, B>::const_iterator UnionView<A, B>::begin() const
+{
+    return const_iterator(a.begin(), a.end(),
+                          FilterIterator<B, A, false>(b.begin(), b.end(), &a));
+}
+
+template <class A, class B>
+typename UnionView<A, B>::const_iterator UnionView<A, B>::end() const
+{
+    return const_iterator(a.end(), a.end(),
+                          FilterIterator<B, A, false>(b.end(), b.end(), &a));
+}
+
+template <class A, class B>
+bool UnionView<A, B>::contains(int anInt) const
+{
+    return a.contains(anInt) || b.contains(anInt);
+}
+
+template <class A, class B>
+int UnionView<A, B>::size() const
+{
+    int count = 0;
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        count++;
+    }
+    return count;
+}
+
+template <class A, class B>
+bool UnionView<A, B>::isEmpty() const
+{
+    return !(begin() != end());
+}
+
+////////////////////////////////////////////////////////////////////
+// IntersectView<A, B>
+
+template <class A, class B>
+IntersectView<A, B>::IntersectView(const A& a, const B& b) : a(a), b(b) { }
+
+template <class A, class B>
+typename IntersectView<A, B>::const_iterator IntersectView<A, B>::begin() const
+{
+    return const_iterator(a.begin(), a.end(), &b);
+}
+
+template <class A, class B>
+typename IntersectView<A, B>::const_iterator IntersectView<A, B>::end() const
+{
+    return const_iterator(a.end(), a.end(), &b);
+}
+
+template <class A, class B>
+bool IntersectView<A, B>::contains(int anInt) const
+{
+    return a.contains(anInt) && b.contains(anInt);
+}
+
+template <class A, class B>
+int IntersectView<A, B>::size() const
+{
+    int count = 0;
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        count++;
+    }
+    return count;
+}
+
+template <class A, class B>
+bool IntersectView<A, B>::isEmpty() const
+{
+    return !(begin() != end());
+}
+
+////////////////////////////////////////////////////////////////////
+// SubtractView<A, B>
+
+template <class A, class B>
+SubtractView<A, B>::SubtractView(const A& a, const B& b) : a(a), b(b) { }
+
+template <class A, class B>
+typename SubtractView<A, B>::const_iterator SubtractView<A, B>::begin() const
+{
+    return const_iterator(a.begin(), a.end(), &b);
+}
+
+template <class A, class B>
+typename SubtractView<A, B>::const_iterator SubtractView<A, B>::end() const
+{
+    return const_iterator(a.end(), a.end(), &b);
+}
+
+template <class A, class B>
+bool SubtractView<A, B>::contains(int anInt) const
+{
+    return a.contains(anInt) && !b.contains(anInt);
+}
+
+template <class A, class B>
+int SubtractView<A, B>::size() const
+{
+    int count = 0;
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        count++;
+    }
+    return count;
+}
+
+template <class A, class B>
+bool SubtractView<A, B>::isEmpty() const
+{
+    return !(begin() != end());
+}
+
+////////////////////////////////////////////////////////////////////
+// Non-member functions
+
+template <class A, class B>
+UnionView<A, B> union_view(const A& a, const B& b)
+{
+    return UnionView<A, B>(a, b);
+}
+
+template <class A, class B>
+IntersectView<A, B> intersect_view(const A& a, const B& b)
+{
+    return IntersectView<A, B>(a, b);
+}
+
+template <class A, class B>
+SubtractView<A, B> subtract_view(const A& a, const B& b)
+{
+    return SubtractView<A, B>(a, b);
+}
+
+template <class View>
+IntSet to_intset(const View& view)
+{
+    IntSet result;
+    for (typename View::const_iterator it = view.begin(), last = view.end();
+         it != last; ++it)
+    {
+        result.add(*it);
+    }
+    return result;
+}
@@ -0,0 +1,198 @@
+// FILE: IntSetViews.h - header file for the lazy IntSet set-operation
+//       views
+// CLASS TEMPLATES PROVIDED:
+//   UnionView<A, B>, IntersectView<A, B>, SubtractView<A, B>
+//     (read-only views of the union, intersection and difference of
+//     two operands, whose elements are worked out one at a time as the
+//     view is iterated; no IntSet is built for the result)
+//
+// OPERANDS
+//   An operand is an IntSet or another view (so views compose, as in
+//   intersect_view(union_view(a, b), c)); the operands are the template
+//   parameters A and B. An operand must have begin() and end() (giving
+//   const_iterator's over its elements) and contains(int).
+//   A view refers to IntSet operands (it doesn't copy them) and holds
+//   view operands by value (they are small), so a view stays valid as
+//   long as the IntSet's it is built on are alive and unchanged.
+//
+// ELEMENT ORDER
+//   A view yields its elements in the same order as the corresponding
+//   IntSet operation lays them out:
+//     union_view(a, b)      the elements of a, then those of b not in a
+//     intersect_view(a, b)  the elements of a that are in b
+//     subtract_view(a, b)   the elements of a that are not in b
+//   so, e.g., to_intset(union_view(a, b)) has exactly the elements, in
+//   the same order, of a.unionWith(b).
+//
+// FUNCTIONS
+//   template <class A, class B>
+//   UnionView<A, B> union_view(const A& a, const B& b)
+//   IntersectView<A, B> intersect_view(const A& a, const B& b)
+//   SubtractView<A, B> subtract_view(const A& a, const B& b)
+//     Pre:  (none)
+//     Post: A view of the union (intersection, difference) of a and b
+//           is returned; nothing is computed yet.
+//   template <class View>
+//   IntSet to_intset(const View& view)
+//     Pre:  (none)
+//     Post: An IntSet holding the elements of view (in view order) is
+//           returned.
+//
+// MEMBER FUNCTIONS of each view
+//   const_iterator begin() const
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: Forward iterators (std::forward_iterator_tag) over the
+//           elements of the view are returned; *it is a const int&
+//           (referring into one of the underlying IntSet's). Each ++
+//           takes O(1) expected time per element of the operands it
+//           steps over.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: True is returned if anInt is an element of the view,
+//           otherwise false; takes O(1) expected time per IntSet
+//           involved.
+//   int size() const
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: The # of elements of the view is returned (isEmpty: true
+//           is returned if there are none).
+//     Note: size() iterates the whole view (O(n) time); isEmpty()
+//           stops at the first element.
+
+#ifndef INT_SET_VIEWS_H
+#define INT_SET_VIEWS_H
+
+#include "IntSet.h"
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+
+// base class of all views (used to tell views from IntSet's)
+class SetView { };
+
+// How a view holds an operand of type T: by const reference for an
+// IntSet, by value for a view.
+template <class T>
+struct ViewOperand
+{
+   typedef typename std::conditional<std::is_base_of<SetView, T>::value,
+                                     T, const T&>::type type;
+};
+
+// Iterator over the elements of operand A that are (keepIfIn == true)
+// or are not (keepIfIn == false) in operand B.
+template <class A, class B, bool keepIfIn>
+class FilterIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef int value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const int* pointer;
+   typedef const int& reference;
+   FilterIterator();
+   FilterIterator(typename A::const_iterator cur,
+                  typename A::const_iterator last, const B* other);
+   reference operator*() const;
+   pointer operator->() const;
+   FilterIterator& operator++();
+   FilterIterator operator++(int);
+   bool operator==(const FilterIterator& rhs) const;
+   bool operator!=(const FilterIterator& rhs) const;
+
+private:
+   typename A::const_iterator cur, last;
+   const B* other;
+   void skipUnwanted();
+};
+
+// Iterator over the elements of operand A followed by the elements of
+// operand B that are not in A.
+template <class A, class B>
+class UnionIterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef int value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const int* pointer;
+   typedef const int& reference;
+   UnionIterator();
+   UnionIterator(typename A::const_iterator curA,
+                 typename A::const_iterator lastA,
+                 FilterIterator<B, A, false> curB);
+   reference operator*() const;
+   pointer operator->() const;
+   UnionIterator& operator++();
+   UnionIterator operator++(int);
+   bool operator==(const UnionIterator& rhs) const;
+   bool operator!=(const UnionIterator& rhs) const;
+
+private:
+   typename A::const_iterator curA, lastA;
+   FilterIterator<B, A, false> curB;
+};
+
+template <class A, class B>
+class UnionView : public SetView
+{
+public:
+   typedef UnionIterator<A, B> const_iterator;
+   UnionView(const A& a, const B& b);
+   const_iterator begin() const;
+   const_iterator end() const;
+   bool contains(int anInt) const;
+   int size() const;
+   bool isEmpty() const;
+
+private:
+   typename ViewOperand<A>::type a;
+   typename ViewOperand<B>::type b;
+};
+
+template <class A, class B>
+class IntersectView : public SetView
+{
+public:
+   typedef FilterIterator<A, B, true> const_iterator;
+   IntersectView(const A& a, const B& b);
+   const_iterator begin() const;
+   const_iterator end() const;
+   bool contains(int anInt) const;
+   int size() const;
+   bool isEmpty() const;
+
+private:
+   typename ViewOperand<A>::type a;
+   typename ViewOperand<B>::type b;
+};
+
+template <class A, class B>
+class SubtractView : public SetView
+{
+public:
+   typedef FilterIterator<A, B, false> const_iterator;
+   SubtractView(const A& a, const B& b);
+   const_iterator begin() const;
+   const_iterator end() const;
+   bool contains(int anInt) const;
+   int size() const;
+   bool isEmpty() const;
+
+private:
+   typename ViewOperand<A>::type a;
+   typename ViewOperand<B>::type b;
+};
+
+template <class A, class B>
+UnionView<A, B> union_view(const A& a, const B& b);
+template <class A, class B>
+IntersectView<A, B> intersect_view(const A& a, const B& b);
+template <class A, class B>
+SubtractView<A, B> subtract_view(const A& a, const B& b);
+template <class View>
+IntSet to_intset(const View& view);
+
+#include "IntSetViews.cpp"
+#endif
@@ -0,0 +1,144 @@
+// FILE: ParallelBench.cpp
+//       A non-interactive scaling benchmark for ParallelSetOps: each
+//       operation is timed on 1, 2, 4, ... threads (up to the # of
+//       hardware threads, or maxThreads) and every result is checked
+//       against the IntSet member function, which is the oracle
+//       (same elements in the same membership order).
+//
+// USAGE: ./a2parbench [n [maxThreads]]
+//        where n is the # of elements of each operand (default
+//        4000000).
+// NOTE: Times are wall-clock (std::chrono::steady_clock), since CPU
+//       time (clock()) adds up the time of all threads.
+
+#include "IntSet.h"
+#include "ParallelSetOps.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+using namespace std;
+
+typedef IntSet (*ParallelOp)(const IntSet&, const IntSet&, int);
+
+// PROTOTYPES for functions used by this benchmark program:
+
+double seconds_since(chrono::steady_clock::time_point start);
+// Pre:  (none)
+// Post: The wall-clock time (in seconds) elapsed since start is
+//       returned.
+
+string contents(const IntSet& is);
+// Pre:  (none)
+// Post: The elements of is, in membership order, as written by
+//       DumpData, are returned.
+
+void bench_scaling(const char label[], const IntSet& is1,
+                   const IntSet& is2, int maxThreads);
+// Pre:  maxThreads >= 1
+// Post: unionWith, intersect and subtract of is1 and is2 have been
+//       timed sequentially (the IntSet member functions) and with
+//       ParallelSetOps on 1, 2, 4, ... maxThreads threads; the times,
+//       speedups over the sequential time, and any result that differs
+//       from the sequential one have been reported on cout.
+
+int main(int argc, char* argv[])
+{
+   int n = 4000000;
+   int maxThreads = ParallelSetOps::default_threads();
+   if (argc > 1)
+      n = atoi(argv[1]);
+   if (argc > 2)
+      maxThreads = atoi(argv[2]);
+   if (n < 1)
+      n = 1;
+   if (maxThreads < 1)
+      maxThreads = 1;
+
+   cout << "ParallelSetOps scaling, " << n << " elements per operand, up to "
+        << maxThreads << " threads ("
+        << ParallelSetOps::default_threads() << " hardware threads)" << endl;
+
+   // sorted form: multiples of 2 and multiples of 3
+   {
+      IntSet is1(n), is2(n);
+      for (int i = 0; i < n; ++i)
+      {
+         is1.add(2 * i);
+         is2.add(3 * i);
+      }
+      bench_scaling("Sorted IntSets:", is1, is2, maxThreads);
+   }
+
+   // hashed (unsorted) form: pseudo-random values, about half shared
+   {
+      IntSet is1(n), is2(n);
+      unsigned seed = 99u;
+      for (int i = 0; i < n; ++i)
+      {
+         seed = seed * 1103515245u + 12345u;
+         is1.add(int(seed % unsigned(2 * n)));
+         seed = seed * 1103515245u + 12345u;
+         is2.add(int(seed % unsigned(2 * n)));
+      }
+      bench_scaling("Unsorted IntSets:", is1, is2, maxThreads);
+   }
+   return EXIT_SUCCESS;
+}
+
+double seconds_since(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+string contents(const IntSet& is)
+{
+   ostringstream out;
+   is.DumpData(out);
+   return out.str();
+}
+
+void bench_scaling(const char label[], const IntSet& is1,
+                   const IntSet& is2, int maxThreads)
+{
+   const char* names[3] = { "unionWith", "intersect", "subtract" };
+   ParallelOp ops[3] = { ParallelSetOps::unionWith,
+                         ParallelSetOps::intersect,
+                         ParallelSetOps::subtract };
+
+   cout << label << endl;
+   for (int op = 0; op < 3; ++op)
+   {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      IntSet oracle = (op == 0) ? is1.unionWith(is2)
+                    : (op == 1) ? is1.intersect(is2)
+                    : is1.subtract(is2);
+      double sequential = seconds_since(start);
+      string expected = contents(oracle);
+
+      cout << "   " << left << setw(10) << names[op] << right
+           << " sequential" << fixed << setprecision(3)
+           << setw(9) << sequential * 1e3 << " ms" << endl;
+
+      for (int threads = 1; ; threads *= 2)
+      {
+         if (threads > maxThreads)
+            threads = maxThreads;
+         start = chrono::steady_clock::now();
+         IntSet result = ops[op](is1, is2, threads);
+         double secs = seconds_since(start);
+
+         cout << "   " << setw(10) << "" << setw(3) << threads
+              << " threads" << setw(9) << secs * 1e3 << " ms"
+              << setprecision(2) << setw(8) << sequential / secs << "x"
+              << setprecision(3);
+         if (!(result == oracle) || contents(result) != expected)
+            cout << "   *** result differs from IntSet::" << names[op];
+         cout << endl;
+         if (threads == maxThreads)
+            break;
+      }
+   }
+}
@@ -0,0 +1,264 @@
+// FILE: ParallelSetOps.cpp
+//       Implementation file for the ParallelSetOps class
+//       (See ParallelSetOps.h for documentation.)
+//
+// Every operation works in two phases, each run by threads workers:
+//   1. Worker k computes part k of the result into a buffer of its
+//      own (for unionWith, parts 0..threads-1 are the live entries of
+//      is1 and parts threads..2*threads-1 are the members of is2 not
+//      in is1, which is the order IntSet::unionWith produces).
+//   2. gather allocates the result once, and the parts are copied to
+//      their offsets in it (found from the part sizes) in parallel.
+// ParallelSetOps is a friend of IntSet so it can read the entries of
+// the operands and fill in the entries of the result directly.
+
+#include "ParallelSetOps.h"
+#include "SetKernels.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+   // Runs work(0), work(1), ..., work(n - 1) on n threads (work(0) on
+   // the calling thread) and waits for all of them to finish.
+   template <class Work>
+   void runParallel(int n, Work work)
+   {
+      std::vector<std::thread> pool;
+      for (int k = 1; k < n; ++k)
+         pool.push_back(std::thread(work, k));
+      work(0);
+      for (size_t t = 0; t < pool.size(); ++t)
+         pool[t].join();
+   }
+
+   // start of run k of n equal runs of size positions
+   int runStart(int size, int k, int n)
+   {
+      return int((long long)size * k / n);
+   }
+
+   // position of the first value of a[0..na-1] that is >= value
+   int lowerBound(const int* a, int na, int value)
+   {
+      return int(std::lower_bound(a, a + na, value) - a);
+   }
+}
+
+bool ParallelSetOps::bothSorted(const IntSet& is1, const IntSet& is2)
+{
+   return is1.sorted && is2.sorted &&
+          is1.filled == is1.used && is2.filled == is2.used;
+}
+
+int ParallelSetOps::default_threads()
+{
+   int n = int(std::thread::hardware_concurrency());
+   return (n < 1) ? 1 : n;
+}
+
+IntSet ParallelSetOps::intersect(const IntSet& is1, const IntSet& is2,
+                                 int threads)
+{
+   if (threads < 2 || is1.used + is2.used < PARALLEL_MIN_SIZE)
+   {
+      return is1.intersect(is2);
+   }
+
+   std::vector<int*> parts(threads);
+   std::vector<int> counts(threads);
+   const bool sortedForm = bothSorted(is1, is2);
+
+   runParallel(threads, [&](int k)
+   {
+      if (sortedForm)
+      {
+         const int *a = is1.data, *b = is2.data;
+         int i0 = runStart(is1.used, k, threads),
+             i1 = runStart(is1.used, k + 1, threads);
+         int j0 = (i0 == 0) ? 0 : lowerBound(b, is2.used, a[i0]),
+             j1 = (i1 == is1.used) ? is2.used : lowerBound(b, is2.used, a[i1]);
+         if (j1 < j0)
+            j1 = j0;
+         parts[k] = new int[std::min(i1 - i0, j1 - j0) + 1];
+         counts[k] = sortedIntersect(a + i0, i1 - i0, b + j0, j1 - j0, parts[k]);
+      }
+      else
+      {
+         int p0 = runStart(is1.filled, k, threads),
+             p1 = runStart(is1.filled, k + 1, threads);
+         int count = 0;
+         parts[k] = new int[p1 - p0 + 1];
+         for (int p = p0; p < p1; ++p)
+         {
+            if ((is1.filled == is1.used || is1.isLive(p)) &&
+                is2.contains(is1.data[p]))
+            {
+               parts[k][count++] = is1.data[p];
+            }
+         }
+         counts[k] = count;
+      }
+   });
+
+   return gather(&parts[0], &counts[0], threads, is1.resource);
+}
+
+IntSet ParallelSetOps::subtract(const IntSet& is1, const IntSet& is2,
+                                int threads)
+{
+   if (threads < 2 || is1.used + is2.used < PARALLEL_MIN_SIZE)
+   {
+      return is1.subtract(is2);
+   }
+
+   std::vector<int*> parts(threads);
+   std::vector<int> counts(threads);
+   const bool sortedForm = bothSorted(is1, is2);
+
+   runParallel(threads, [&](int k)
+   {
+      if (sortedForm)
+      {
+         const int *a = is1.data, *b = is2.data;
+         int i0 = runStart(is1.used, k, threads),
+             i1 = runStart(is1.used, k + 1, threads);
+         int j0 = (i0 == 0) ? 0 : lowerBound(b, is2.used, a[i0]),
+             j1 = (i1 == is1.used) ? is2.used : lowerBound(b, is2.used, a[i1]);
+         if (j1 < j0)
+            j1 = j0;
+         parts[k] = new int[i1 - i0 + 1];
+         counts[k] = sortedSubtract(a + i0, i1 - i0, b + j0, j1 - j0, parts[k]);
+      }
+      else
+      {
+         int p0 = runStart(is1.filled, k, threads),
+             p1 = runStart(is1.filled, k + 1, threads);
+         int count = 0;
+         parts[k] = new int[p1 - p0 + 1];
+         for (int p = p0; p < p1; ++p)
+         {
+            if ((is1.filled == is1.used || is1.isLive(p)) &&
+                !is2.contains(is1.data[p]))
+            {
+               parts[k][count++] = is1.data[p];
+            }
+         }
+         counts[k] = count;
+      }
+   });
+
+   return gather(&parts[0], &counts[0], threads, is1.resource);
+}
+
+IntSet ParallelSetOps::unionWith(const IntSet& is1, const IntSet& is2,
+                                 int threads)
+{
+   if (threads < 2 || is1.used + is2.used < PARALLEL_MIN_SIZE)
+   {
+      return is1.unionWith(is2);
+   }
+
+   std::vector<int*> parts(2 * threads);
+   std::vector<int> counts(2 * threads);
+   const bool sortedForm = bothSorted(is1, is2);
+
+   runParallel(threads, [&](int k)
+   {
+      // part k: the live entries of run k of is1
+      int p0 = runStart(is1.filled, k, threads),
+          p1 = runStart(is1.filled, k + 1, threads);
+      int count = 0;
+      parts[k] = new int[p1 - p0 + 1];
+      for (int p = p0; p < p1; ++p)
+      {
+         if (is1.filled == is1.used || is1.isLive(p))
+         {
+            parts[k][count++] = is1.data[p];
+         }
+      }
+      counts[k] = count;
+
+      // part threads + k: the members of run k of is2 not in is1
+      int* out;
+      if (sortedForm)
+      {
+         const int *a = is1.data, *b = is2.data;
+         int j0 = runStart(is2.used, k, threads),
+             j1 = runStart(is2.used, k + 1, threads);
+         int i0 = (j0 == 0) ? 0 : lowerBound(a, is1.used, b[j0]),
+             i1 = (j1 == is2.used) ? is1.used : lowerBound(a, is1.used, b[j1]);
+         if (i1 < i0)
+            i1 = i0;
+         out = new int[j1 - j0 + 1];
+         count = sortedSubtract(b + j0, j1 - j0, a + i0, i1 - i0, out);
+      }
+      else
+      {
+         p0 = runStart(is2.filled, k, threads);
+         p1 = runStart(is2.filled, k + 1, threads);
+         count = 0;
+         out = new int[p1 - p0 + 1];
+         for (int p = p0; p < p1; ++p)
+         {
+            if ((is2.filled == is2.used || is2.isLive(p)) &&
+                !is1.contains(is2.data[p]))
+            {
+               out[count++] = is2.data[p];
+            }
+         }
+      }
+      parts[threads + k] = out;
+      counts[threads + k] = count;
+   });
+
+   return gather(&parts[0], &counts[0], 2 * threads, is1.resource);
+}
+
+IntSet ParallelSetOps::gather(int** parts, const int* counts, int nParts,
+                              memory_resource* resource)
+{
+   std::vector<int> offset(nParts + 1, 0);
+   for (int k = 0; k < nParts; ++k)
+   {
+      offset[k + 1] = offset[k] + counts[k];
+   }
+
+   IntSet temp(offset[nParts], resource);
+   std::vector<char> partSorted(nParts, 1);
+   int workers = std::min(nParts, default_threads());
+   if (workers < 2)
+   {
+      workers = 2;
+   }
+
+   runParallel(workers, [&](int w)
+   {
+      for (int k = w; k < nParts; k += workers)
+      {
+         int* to = temp.data + offset[k];
+         for (int i = 0; i < counts[k]; ++i)
+         {
+            to[i] = parts[k][i];
+            if (i > 0 && to[i] < to[i - 1])
+               partSorted[k] = 0;
+         }
+         delete [] parts[k];
+      }
+   });
+
+   temp.filled = temp.used = offset[nParts];
+   temp.sorted = true;
+   for (int k = 0; k < nParts && temp.sorted; ++k)
+   {
+      if (!partSorted[k] ||
+          (counts[k] > 0 && offset[k] > 0 &&
+           temp.data[offset[k]] < temp.data[offset[k] - 1]))
+      {
+         temp.sorted = false;
+      }
+   }
+   temp.rebuildIndex();
+   return temp;
+}
@@ -0,0 +1,68 @@
+// FILE: ParallelSetOps.h - header file for the ParallelSetOps class
+// CLASS PROVIDED: ParallelSetOps (multi-threaded versions of the IntSet
+//                 set operations, for very large IntSets)
+//
+// Each function returns exactly what the IntSet member function of the
+// same name returns (same elements, same membership order), but splits
+// the work across up to threads threads:
+//   - When both operands are in sorted form with no removed entries
+//     (the case in which IntSet uses the sorted kernels), the invoking
+//     set (or, for unionWith, the other set) is cut into equal runs of
+//     positions, and each run is paired with the value range of the
+//     other set that can hold matches for it (found by binary search).
+//     Each thread runs the sorted kernel on its pair.
+//   - Otherwise each thread takes an equal run of positions of one
+//     set and probes the hash index of the other.
+// In both cases the per-thread results are already in order relative
+// to one another, so they are simply concatenated (in parallel) into
+// the result; no final sort or merge is needed. Only the hash index of
+// the result is built by a single thread.
+// As with the member functions, the result gets its memory from is1's
+// memory_resource.
+//
+// STATIC MEMBER FUNCTIONS
+//   static IntSet unionWith(const IntSet& is1, const IntSet& is2,
+//                           int threads)
+//     Pre:  (none)
+//     Post: is1.unionWith(is2) has been returned.
+//   static IntSet intersect(const IntSet& is1, const IntSet& is2,
+//                           int threads)
+//     Pre:  (none)
+//     Post: is1.intersect(is2) has been returned.
+//   static IntSet subtract(const IntSet& is1, const IntSet& is2,
+//                          int threads)
+//     Pre:  (none)
+//     Post: is1.subtract(is2) has been returned.
+//   static int default_threads()
+//     Pre:  (none)
+//     Post: The # of hardware threads (at least 1) is returned.
+//     Note: For all three operations, threads < 2 or operands with
+//           fewer than PARALLEL_MIN_SIZE elements in all run on the
+//           calling thread (through the IntSet member function),
+//           since starting threads would cost more than it saves.
+//
+// NOTE: Threads are started for each call (std::thread) and joined
+//       before it returns; the operands are only read, so they may be
+//       shared with other threads that only read them too.
+
+#ifndef PARALLEL_SET_OPS_H
+#define PARALLEL_SET_OPS_H
+
+#include "IntSet.h"
+
+class ParallelSetOps
+{
+public:
+   static const int PARALLEL_MIN_SIZE = 65536;
+   static IntSet unionWith(const IntSet& is1, const IntSet& is2, int threads);
+   static IntSet intersect(const IntSet& is1, const IntSet& is2, int threads);
+   static IntSet subtract(const IntSet& is1, const IntSet& is2, int threads);
+   static int default_threads();
+
+private:
+   static bool bothSorted(const IntSet& is1, const IntSet& is2);
+   static IntSet gather(int** parts, const int* counts, int nParts,
+                        memory_resource* resource);
+};
+
+#endif
@@ -0,0 +1,351 @@
+// FILE: PersistentIntSet.cpp
+//       Implementation file for the PersistentIntSet class
+//       (See PersistentIntSet.h for documentation.)
+// INVARIANT for the PersistentIntSet class:
+// (1) root is null for an empty set; otherwise it is the root of an
+//     AVL tree holding the elements: for every node, the values in its
+//     left subtree are less than its value and those in its right
+//     subtree greater, and the heights of the two subtrees differ by
+//     at most 1.
+// (2) Each node's height and count are those of the subtree rooted at
+//     it (see Node in PersistentIntSet.h).
+// (3) A node is never changed after make() has created it; nodes are
+//     shared by all versions (and all subtrees) that hold them, so
+//     every "change" makes new nodes for the path it affects.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   static int height(const NodePtr& t)
+//   static int count(const NodePtr& t)
+//     Pre:  (none)
+//     Post: The height (count: the # of nodes) of tree t is returned
+//           (0 for an empty tree).
+//   static NodePtr make(int value, const NodePtr& left,
+//                       const NodePtr& right)
+//     Pre:  left and right are AVL trees of values less (greater) than
+//           value whose heights differ by at most 1.
+//     Post: A new node with value, left and right (and its height and
+//           count worked out) is returned.
+//   static NodePtr balance(int value, const NodePtr& left,
+//                          const NodePtr& right)
+//     Pre:  As for make, except that the heights of left and right may
+//           differ by 2 (after an insert into, or erase from, one of
+//           them).
+//     Post: An AVL tree of value and the elements of left and right is
+//           returned (made with a single or double rotation if
+//           needed; only new nodes are made, none is changed).
+//   static NodePtr insert(const NodePtr& t, int anInt)
+//   static NodePtr erase(const NodePtr& t, int anInt)
+//     Pre:  t is an AVL tree.
+//     Post: An AVL tree of the elements of t with anInt added (erase:
+//           removed) is returned; t itself is returned (the very same
+//           pointer) if that leaves the elements unchanged.
+//   static NodePtr eraseMin(const NodePtr& t, int& minValue)
+//     Pre:  t is a non-empty AVL tree.
+//     Post: The smallest element of t has been stored in minValue and
+//           an AVL tree of the other elements is returned.
+//   static NodePtr build(const int* values, int n)
+//     Pre:  values[0] through values[n - 1] are in ascending order.
+//     Post: A perfectly balanced tree of the n values is returned.
+
+#include "PersistentIntSet.h"
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+int PersistentIntSet::height(const NodePtr& t)
+{
+    return t ? t->height : 0;
+}
+
+int PersistentIntSet::count(const NodePtr& t)
+{
+    return t ? t->count : 0;
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::make(int value, const NodePtr& left,
+                                                 const NodePtr& right)
+{
+    shared_ptr<Node> node = make_shared<Node>();
+    node->value = value;
+    node->height = 1 + max(height(left), height(right));
+    node->count = 1 + count(left) + count(right);
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::balance(int value, const NodePtr& left,
+                                                    const NodePtr& right)
+{
+    int hl = height(left), hr = height(right);
+    if (hl > hr + 1)
+    {
+        if (height(left->left) >= height(left->right))
+        {
+            // single rotation: left's left subtree is the tall one
+            return make(left->value, left->left,
+                        make(value, left->right, right));
+        }
+        // double rotation: left's right subtree is the tall one
+        const NodePtr& mid = left->right;
+        return make(mid->value, make(left->value, left->left, mid->left),
+                    make(value, mid->right, right));
+    }
+    if (hr > hl + 1)
+    {
+        if (height(right->right) >= height(right->left))
+        {
+            return make(right->value, make(value, left, right->left),
+                        right->right);
+        }
+        const NodePtr& mid = right->left;
+        return make(mid->value, make(value, left, mid->left),
+                    make(right->value, mid->right, right->right));
+    }
+    return make(value, left, right);
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::insert(const NodePtr& t, int anInt)
+{
+    if (!t)
+    {
+        return make(anInt, NodePtr(), NodePtr());
+    }
+    if (anInt < t->value)
+    {
+        NodePtr left = insert(t->left, anInt);
+        return (left == t->left) ? t : balance(t->value, left, t->right);
+    }
+    if (t->value < anInt)
+    {
+        NodePtr right = insert(t->right, anInt);
+        return (right == t->right) ? t : balance(t->value, t->left, right);
+    }
+    return t;   // already an element
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::erase(const NodePtr& t, int anInt)
+{
+    if (!t)
+    {
+        return t;   // not an element
+    }
+    if (anInt < t->value)
+    {
+        NodePtr left = erase(t->left, anInt);
+        return (left == t->left) ? t : balance(t->value, left, t->right);
+    }
+    if (t->value < anInt)
+    {
+        NodePtr right = erase(t->right, anInt);
+        return (right == t->right) ? t : balance(t->value, t->left, right);
+    }
+
+    // t holds anInt: its successor (if any) takes its place
+    if (!t->left)
+    {
+        return t->right;
+    }
+    if (!t->right)
+    {
+        return t->left;
+    }
+    int successor;
+    NodePtr right = eraseMin(t->right, successor);
+    return balance(successor, t->left, right);
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::eraseMin(const NodePtr& t, int& minValue)
+{
+    if (!t->left)
+    {
+        minValue = t->value;
+        return t->right;
+    }
+    NodePtr left = eraseMin(t->left, minValue);
+    return balance(t->value, left, t->right);
+}
+
+PersistentIntSet::NodePtr PersistentIntSet::build(const int* values, int n)
+{
+    if (n == 0)
+    {
+        return NodePtr();
+    }
+    int mid = n / 2;
+    return make(values[mid], build(values, mid),
+                build(values + mid + 1, n - mid - 1));
+}
+
+PersistentIntSet::PersistentIntSet() { }
+
+PersistentIntSet::PersistentIntSet(const NodePtr& root) : root(root) { }
+
+PersistentIntSet::PersistentIntSet(const IntSet& src)
+{
+    vector<int> values(src.begin(), src.end());
+    if (!src.isSorted())
+    {
+        sort(values.begin(), values.end());
+    }
+    root = build(values.empty() ? 0 : &values[0], int(values.size()));
+}
+
+PersistentIntSet::const_iterator::const_iterator() : depth(0) { }
+
+void PersistentIntSet::const_iterator::pushLeftmost(const Node* node)
+{
+    while (node != 0)
+    {
+        path[depth++] = node;
+        node = node->left.get();
+    }
+}
+
+const int& PersistentIntSet::const_iterator::operator*() const
+{
+    return path[depth - 1]->value;
+}
+
+const int* PersistentIntSet::const_iterator::operator->() const
+{
+    return &path[depth - 1]->value;
+}
+
+PersistentIntSet::const_iterator& PersistentIntSet::const_iterator::operator++()
+{
+    // the next element is the leftmost one of the right subtree, or
+    // else the nearest ancestor not yet visited (already on path)
+    const Node* node = path[--depth];
+    pushLeftmost(node->right.get());
+    return *this;
+}
+
+PersistentIntSet::const_iterator PersistentIntSet::const_iterator::operator++(int)
+{
+    const_iterator before = *this;
+    ++*this;
+    return before;
+}
+
+bool PersistentIntSet::const_iterator::operator==(const const_iterator& rhs) const
+{
+    return depth == rhs.depth &&
+           (depth == 0 || path[depth - 1] == rhs.path[depth - 1]);
+}
+
+bool PersistentIntSet::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return !(*this == rhs);
+}
+
+PersistentIntSet::const_iterator PersistentIntSet::begin() const
+{
+    const_iterator it;
+    it.pushLeftmost(root.get());
+    return it;
+}
+
+PersistentIntSet::const_iterator PersistentIntSet::end() const
+{
+    return const_iterator();
+}
+
+int PersistentIntSet::size() const
+{
+    return count(root);
+}
+
+bool PersistentIntSet::isEmpty() const
+{
+    return !root;
+}
+
+bool PersistentIntSet::contains(int anInt) const
+{
+    const Node* node = root.get();
+    while (node != 0)
+    {
+        if (anInt < node->value)
+        {
+            node = node->left.get();
+        }
+        else if (node->value < anInt)
+        {
+            node = node->right.get();
+        }
+        else
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PersistentIntSet::isSubsetOf(const PersistentIntSet& other) const
+{
+    if (root == other.root)
+    {
+        return true;    // the same version (or both empty)
+    }
+    if (size() > other.size())
+    {
+        return false;
+    }
+
+    // merge the two ascending sequences
+    const_iterator b = other.begin(), bEnd = other.end();
+    for (const_iterator a = begin(), aEnd = end(); a != aEnd; ++a)
+    {
+        while (b != bEnd && *b < *a)
+        {
+            ++b;
+        }
+        if (b == bEnd || *b != *a)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+PersistentIntSet PersistentIntSet::add(int anInt) const
+{
+    return PersistentIntSet(insert(root, anInt));
+}
+
+PersistentIntSet PersistentIntSet::remove(int anInt) const
+{
+    return PersistentIntSet(erase(root, anInt));
+}
+
+IntSet PersistentIntSet::toIntSet() const
+{
+    // added in ascending order, each add is a plain append
+    IntSet result(size());
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        result.add(*it);
+    }
+    return result;
+}
+
+void PersistentIntSet::DumpData(ostream& out) const
+{
+    bool first = true;
+    for (const_iterator it = begin(), last = end(); it != last; ++it)
+    {
+        if (!first)
+            out << "  ";
+        out << *it;
+        first = false;
+    }
+}
+
+bool operator==(const PersistentIntSet& ps1, const PersistentIntSet& ps2)
+{
+    // same size and subset is enough
+    if (ps1.size() != ps2.size())
+        return false;
+    return ps1.isSubsetOf(ps2);
+}
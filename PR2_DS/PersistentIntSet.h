@@ -0,0 +1,170 @@
+// FILE: PersistentIntSet.h - header file for the PersistentIntSet class
+// CLASS PROVIDED: PersistentIntSet (an immutable set of int values whose
+//                 add and remove make a new version of the set, leaving
+//                 the old version as it was; for keeping many versions
+//                 of a set as it evolves)
+//
+// REPRESENTATION
+//   A persistent AVL tree: the elements are kept in a balanced binary
+//   search tree whose nodes are never changed once made and are shared
+//   (through std::shared_ptr) by every version that contains them. add
+//   and remove copy only the nodes on the path from the root to the
+//   element (and those of at most a few rotations), so a new version
+//   takes O(log n) time and memory and shares all other nodes with the
+//   version it was made from. A version is freed node by node as the
+//   last version using each node goes away.
+//
+// CONSTRUCTORS
+//   PersistentIntSet()
+//     Post: The invoking PersistentIntSet is an empty set.
+//   explicit PersistentIntSet(const IntSet& src)
+//     Pre:  (none)
+//     Post: The invoking PersistentIntSet has the elements of src.
+//     Note: Takes O(n log n) time (the elements are sorted and a
+//           perfectly balanced tree is built from them).
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   int size() const
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: The # of elements is returned (isEmpty: true is returned
+//           if there are none); takes O(1) time.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: True is returned if anInt is an element of the invoking
+//           PersistentIntSet, otherwise false; takes O(log n) time.
+//   bool isSubsetOf(const PersistentIntSet& other) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking
+//           PersistentIntSet are also elements of other, otherwise
+//           false (O(1) time when both are the same version).
+//   PersistentIntSet add(int anInt) const
+//     Pre:  (none)
+//     Post: A version of the invoking PersistentIntSet with anInt
+//           added is returned (the invoking PersistentIntSet itself is
+//           unchanged); if anInt was already an element, the version
+//           returned is the invoking one.
+//   PersistentIntSet remove(int anInt) const
+//     Pre:  (none)
+//     Post: A version of the invoking PersistentIntSet with anInt
+//           removed is returned (the invoking PersistentIntSet itself
+//           is unchanged); if anInt was not an element, the version
+//           returned is the invoking one.
+//     Note: add and remove take O(log n) time and make at most
+//           O(log n) new nodes (one allocation each).
+//   IntSet toIntSet() const
+//     Pre:  (none)
+//     Post: An IntSet with the elements of the invoking
+//           PersistentIntSet (added in ascending order, so it is in
+//           sorted form) is returned.
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: The elements (in ascending order) have been inserted into
+//           out with 2 spaces separating one item from another.
+//
+// ITERATORS
+//   class const_iterator
+//     A forward iterator (std::forward_iterator_tag) over the elements
+//     in ascending order; *it is a const int&. Iterators stay valid as
+//     long as the version they were obtained from is alive (no
+//     version is ever changed).
+//   const_iterator begin() const
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: The iterator to the smallest element (end() if there are
+//           none), and the past-the-end iterator, are returned.
+//     Note: With begin(), end() and contains(), a PersistentIntSet can
+//           be an operand of the lazy views of IntSetViews.h.
+//
+// NON-MEMBER FUNCTION
+//   bool operator==(const PersistentIntSet& ps1,
+//                   const PersistentIntSet& ps2)
+//     Pre:  (none)
+//     Post: True is returned if ps1 and ps2 have the same elements,
+//           otherwise false is returned.
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may be used with
+//   PersistentIntSet objects; a copy is a snapshot that shares the
+//   whole tree, so it takes O(1) time and no memory. Since nodes are
+//   never changed and their reference counts are atomic, versions may
+//   be read, copied and destroyed in different threads.
+
+#ifndef PERSISTENT_INT_SET_H
+#define PERSISTENT_INT_SET_H
+
+#include "IntSet.h"
+#include <iostream>
+#include <memory>
+#include <iterator>   // provides std::forward_iterator_tag
+#include <cstddef>    // provides std::ptrdiff_t
+
+class PersistentIntSet
+{
+private:
+   struct Node;
+   typedef std::shared_ptr<const Node> NodePtr;
+
+public:
+   // deepest possible path of an AVL tree of up to 2^31 elements
+   static const int MAX_HEIGHT = 46;
+
+   PersistentIntSet();
+   explicit PersistentIntSet(const IntSet& src);
+
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef int value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const int* pointer;
+      typedef const int& reference;
+      const_iterator();
+      reference operator*() const;
+      pointer operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+   private:
+      friend class PersistentIntSet;
+      const Node* path[MAX_HEIGHT];   // top: the current node; below
+      int depth;                      // it, ancestors still to visit
+      void pushLeftmost(const Node* node);
+   };
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   bool isSubsetOf(const PersistentIntSet& other) const;
+   PersistentIntSet add(int anInt) const;
+   PersistentIntSet remove(int anInt) const;
+   IntSet toIntSet() const;
+   void DumpData(std::ostream& out) const;
+
+private:
+   struct Node
+   {
+      int value;
+      int height;   // # of nodes on the longest path down from here
+      int count;    // # of nodes in the subtree rooted here
+      NodePtr left, right;
+   };
+   NodePtr root;
+   explicit PersistentIntSet(const NodePtr& root);
+   static int height(const NodePtr& t);
+   static int count(const NodePtr& t);
+   static NodePtr make(int value, const NodePtr& left, const NodePtr& right);
+   static NodePtr balance(int value, const NodePtr& left, const NodePtr& right);
+   static NodePtr insert(const NodePtr& t, int anInt);
+   static NodePtr erase(const NodePtr& t, int anInt);
+   static NodePtr eraseMin(const NodePtr& t, int& minValue);
+   static NodePtr build(const int* values, int n);
+};
+
+bool operator==(const PersistentIntSet& ps1, const PersistentIntSet& ps2);
+
+#endif
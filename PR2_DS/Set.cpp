@@ -0,0 +1,689 @@
+// FILE: Set.cpp
+//       Implementation file for the Set class template and its
+//       storage policies (See Set.h for documentation.)
+//       This file is included by Set.h and is not compiled on its own.
+//
+// INVARIANT for FixedStorage<T, N> and DynamicStorage<T>:
+// (1) The elements are held in data[0] through data[used - 1] in
+//     order of membership timing; remove shifts the later elements
+//     down to close the gap. FixedStorage's data is a member array of
+//     N entries; DynamicStorage's data is a dynamic array of capacity
+//     entries (null while capacity is 0) that is doubled when full.
+//
+// INVARIANT for SortedStorage<T>:
+// (1) The elements are held in items in strictly ascending order.
+//
+// INVARIANT for HashedStorage<T>:
+// (1) The elements are held in items in order of membership timing;
+//     remove closes the gap (as DynamicStorage does) and renumbers
+//     the slots of the elements after it, so it takes time linear in
+//     the # of elements after the one removed.
+// (2) While items is empty index may be null; otherwise index is a
+//     hash index (see HashIndex.h, whose code IntSet shares) of
+//     2^indexBits slots with at least twice as many slots as
+//     elements, keyed by std::hash<T>: each element items.at(p) has
+//     exactly one slot, holding p + 1, and all other slots hold 0.
+
+#include <algorithm>   // provides std::lower_bound, std::set_union,
+                       // std::set_intersection, std::set_difference
+#include "HashIndex.h"
+
+////////////////////////////////////////////////////////////////////
+// FixedStorage<T, N>
+
+template <class T, int N>
+FixedStorage<T, N>::FixedStorage() : used(0) { }
+
+template <class T, int N>
+int FixedStorage<T, N>::size() const
+{
+    return used;
+}
+
+template <class T, int N>
+const T& FixedStorage<T, N>::at(int pos) const
+{
+    return data[pos];
+}
+
+template <class T, int N>
+bool FixedStorage<T, N>::find(const T& x) const
+{
+    for (int i = 0; i < used; i++)
+    {
+        if (data[i] == x)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T, int N>
+bool FixedStorage<T, N>::insert(const T& x)
+{
+    if (find(x))
+    {
+        return false;
+    }
+    append(x);
+    return true;
+}
+
+template <class T, int N>
+void FixedStorage<T, N>::append(const T& x)
+{
+    data[used++] = x;
+}
+
+template <class T, int N>
+bool FixedStorage<T, N>::erase(const T& x)
+{
+    for (int i = 0; i < used; i++)
+    {
+        if (data[i] == x)
+        {
+            for (int j = i + 1; j < used; j++)
+            {
+                data[j - 1] = data[j];
+            }
+            used--;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T, int N>
+void FixedStorage<T, N>::clear()
+{
+    used = 0;
+}
+
+template <class T, int N>
+void FixedStorage<T, N>::reserve(int) { }
+
+////////////////////////////////////////////////////////////////////
+// DynamicStorage<T>
+
+template <class T>
+DynamicStorage<T>::DynamicStorage() : data(0), capacity(0), used(0) { }
+
+template <class T>
+DynamicStorage<T>::DynamicStorage(const DynamicStorage& src)
+    : data(0), capacity(src.used), used(src.used)
+{
+    if (capacity > 0)
+    {
+        data = new T[capacity];
+        for (int i = 0; i < used; i++)
+        {
+            data[i] = src.data[i];
+        }
+    }
+}
+
+template <class T>
+DynamicStorage<T>::~DynamicStorage()
+{
+    delete [] data;
+}
+
+template <class T>
+DynamicStorage<T>& DynamicStorage<T>::operator=(const DynamicStorage& rhs)
+{
+    if (this != &rhs)
+    {
+        if (capacity < rhs.used)
+        {
+            T* temp = new T[rhs.used];
+            delete [] data;
+            data = temp;
+            capacity = rhs.used;
+        }
+        for (int i = 0; i < rhs.used; i++)
+        {
+            data[i] = rhs.data[i];
+        }
+        used = rhs.used;
+    }
+    return *this;
+}
+
+template <class T>
+int DynamicStorage<T>::size() const
+{
+    return used;
+}
+
+template <class T>
+const T& DynamicStorage<T>::at(int pos) const
+{
+    return data[pos];
+}
+
+template <class T>
+bool DynamicStorage<T>::find(const T& x) const
+{
+    for (int i = 0; i < used; i++)
+    {
+        if (data[i] == x)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+bool DynamicStorage<T>::insert(const T& x)
+{
+    if (find(x))
+    {
+        return false;
+    }
+    append(x);
+    return true;
+}
+
+template <class T>
+void DynamicStorage<T>::append(const T& x)
+{
+    insert_at(used, x);
+}
+
+template <class T>
+bool DynamicStorage<T>::erase(const T& x)
+{
+    for (int i = 0; i < used; i++)
+    {
+        if (data[i] == x)
+        {
+            erase_at(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class T>
+void DynamicStorage<T>::clear()
+{
+    used = 0;
+}
+
+template <class T>
+void DynamicStorage<T>::reserve(int n)
+{
+    if (n <= capacity)
+    {
+        return;
+    }
+    T* temp = new T[n];
+    for (int i = 0; i < used; i++)
+    {
+        temp[i] = data[i];
+    }
+    delete [] data;
+    data = temp;
+    capacity = n;
+}
+
+template <class T>
+const T* DynamicStorage<T>::begin() const
+{
+    return data;
+}
+
+template <class T>
+const T* DynamicStorage<T>::end() const
+{
+    return data + used;
+}
+
+template <class T>
+void DynamicStorage<T>::insert_at(int pos, const T& x)
+{
+    if (used == capacity)
+    {
+        reserve(capacity < 4 ? 4 : 2 * capacity);
+    }
+    for (int i = used; i > pos; i--)
+    {
+        data[i] = data[i - 1];
+    }
+    data[pos] = x;
+    used++;
+}
+
+template <class T>
+void DynamicStorage<T>::erase_at(int pos)
+{
+    for (int i = pos + 1; i < used; i++)
+    {
+        data[i - 1] = data[i];
+    }
+    used--;
+}
+
+////////////////////////////////////////////////////////////////////
+// SortedStorage<T>
+
+template <class T>
+int SortedStorage<T>::lowerBound(const T& x) const
+{
+    return int(std::lower_bound(items.begin(), items.end(), x) - items.begin());
+}
+
+template <class T>
+int SortedStorage<T>::size() const
+{
+    return items.size();
+}
+
+template <class T>
+const T& SortedStorage<T>::at(int pos) const
+{
+    return items.at(pos);
+}
+
+template <class T>
+bool SortedStorage<T>::find(const T& x) const
+{
+    int pos = lowerBound(x);
+    return pos < items.size() && !(x < items.at(pos));
+}
+
+template <class T>
+bool SortedStorage<T>::insert(const T& x)
+{
+    int pos = lowerBound(x);
+    if (pos < items.size() && !(x < items.at(pos)))
+    {
+        return false;
+    }
+    items.insert_at(pos, x);
+    return true;
+}
+
+template <class T>
+void SortedStorage<T>::append(const T& x)
+{
+    items.append(x);
+}
+
+template <class T>
+bool SortedStorage<T>::erase(const T& x)
+{
+    int pos = lowerBound(x);
+    if (pos < items.size() && !(x < items.at(pos)))
+    {
+        items.erase_at(pos);
+        return true;
+    }
+    return false;
+}
+
+template <class T>
+void SortedStorage<T>::clear()
+{
+    items.clear();
+}
+
+template <class T>
+void SortedStorage<T>::reserve(int n)
+{
+    items.reserve(n);
+}
+
+template <class T>
+const T* SortedStorage<T>::begin() const
+{
+    return items.begin();
+}
+
+template <class T>
+const T* SortedStorage<T>::end() const
+{
+    return items.end();
+}
+
+template <class T>
+void SortedStorage<T>::assign(const T* first, const T* last)
+{
+    items.clear();
+    items.reserve(int(last - first));
+    for ( ; first != last; ++first)
+    {
+        items.append(*first);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+// HashedStorage<T>
+
+template <class T>
+HashedStorage<T>::HashedStorage() : index(0), indexBits(0) { }
+
+template <class T>
+HashedStorage<T>::HashedStorage(const HashedStorage& src)
+    : items(src.items), index(0), indexBits(src.indexBits)
+{
+    if (src.index != 0)
+    {
+        index = new int[1 << indexBits];
+        for (int s = 0; s < (1 << indexBits); s++)
+        {
+            index[s] = src.index[s];
+        }
+    }
+}
+
+template <class T>
+HashedStorage<T>::~HashedStorage()
+{
+    delete [] index;
+}
+
+template <class T>
+HashedStorage<T>& HashedStorage<T>::operator=(const HashedStorage& rhs)
+{
+    if (this != &rhs)
+    {
+        HashedStorage temp(rhs);
+        items = temp.items;
+        int* oldIndex = index;
+        index = temp.index;
+        indexBits = temp.indexBits;
+        temp.index = oldIndex;
+    }
+    return *this;
+}
+
+template <class T>
+unsigned HashedStorage<T>::hashOf(const T& x)
+{
+    return unsigned(std::hash<T>()(x));
+}
+
+template <class T>
+int HashedStorage<T>::findSlot(const T& x) const
+{
+    const DynamicStorage<T>& entries = items;
+    return hashFindSlot(index, indexBits, hashOf(x),
+                        [&entries, &x](int p) { return entries.at(p) == x; });
+}
+
+template <class T>
+void HashedStorage<T>::rebuildIndex(int bits)
+{
+    delete [] index;
+    indexBits = bits;
+    index = new int[1 << indexBits];
+    hashClear(index, indexBits);
+    for (int p = 0; p < items.size(); p++)
+    {
+        index[findSlot(items.at(p))] = p + 1;
+    }
+}
+
+template <class T>
+int HashedStorage<T>::size() const
+{
+    return items.size();
+}
+
+template <class T>
+const T& HashedStorage<T>::at(int pos) const
+{
+    return items.at(pos);
+}
+
+template <class T>
+bool HashedStorage<T>::find(const T& x) const
+{
+    return index != 0 && index[findSlot(x)] != 0;
+}
+
+template <class T>
+bool HashedStorage<T>::insert(const T& x)
+{
+    if (find(x))
+    {
+        return false;
+    }
+    append(x);
+    return true;
+}
+
+template <class T>
+void HashedStorage<T>::append(const T& x)
+{
+    if (2 * (items.size() + 1) > (1 << indexBits))
+    {
+        reserve(2 * (items.size() + 1));
+    }
+    items.append(x);
+    index[findSlot(x)] = items.size();
+}
+
+template <class T>
+bool HashedStorage<T>::erase(const T& x)
+{
+    if (!find(x))
+    {
+        return false;
+    }
+
+    // backward-shift deletion of the element's slot (as in
+    // IntSet::remove)
+    const DynamicStorage<T>& entries = items;
+    int slot = findSlot(x);
+    int pos = index[slot] - 1;
+    hashEraseSlot(index, indexBits, slot,
+                  [&entries](int p) { return hashOf(entries.at(p)); });
+
+    // renumber the slots of the elements after pos for the places
+    // they are about to move down to (going up from pos, a slot done
+    // already refers to the element before its own, which is never
+    // the one being looked for), then close the gap, keeping the
+    // membership order
+    for (int p = pos + 1; p < items.size(); p++)
+    {
+        index[findSlot(items.at(p))] = p;
+    }
+    items.erase_at(pos);
+    return true;
+}
+
+template <class T>
+void HashedStorage<T>::clear()
+{
+    items.clear();
+    if (index != 0)
+    {
+        hashClear(index, indexBits);
+    }
+}
+
+template <class T>
+void HashedStorage<T>::reserve(int n)
+{
+    int bits = hashIndexBits(n);
+    items.reserve(n);
+    if (bits > indexBits)
+    {
+        rebuildIndex(bits);
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+// Set<T, Storage>
+
+template <class T, class Storage>
+Set<T, Storage>::Set() { }
+
+template <class T, class Storage>
+int Set<T, Storage>::size() const
+{
+    return store.size();
+}
+
+template <class T, class Storage>
+bool Set<T, Storage>::isEmpty() const
+{
+    return store.size() == 0;
+}
+
+template <class T, class Storage>
+bool Set<T, Storage>::contains(const T& item) const
+{
+    return store.find(item);
+}
+
+template <class T, class Storage>
+const T& Set<T, Storage>::element(int pos) const
+{
+    return store.at(pos);
+}
+
+template <class T, class Storage>
+bool Set<T, Storage>::isSubsetOf(const Set& otherSet) const
+{
+    if (size() > otherSet.size())
+    {
+        return false;
+    }
+    for (int i = 0; i < size(); i++)
+    {
+        if (!otherSet.contains(store.at(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::DumpData(std::ostream& out) const
+{
+    for (int i = 0; i < size(); i++)
+    {
+        if (i > 0)
+            out << "  ";
+        out << store.at(i);
+    }
+}
+
+template <class T, class Storage>
+Set<T, Storage> Set<T, Storage>::unionWith(const Set& otherSet) const
+{
+    Set temp;
+    unite(otherSet, temp, std::integral_constant<bool, Storage::ORDERED>());
+    return temp;
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::unite(const Set& otherSet, Set& result,
+                            std::true_type) const
+{
+    // both are in ascending order: merge them
+    T* merged = new T[size() + otherSet.size()];
+    T* last = std::set_union(store.begin(), store.end(),
+                             otherSet.store.begin(), otherSet.store.end(),
+                             merged);
+    result.store.assign(merged, last);
+    delete [] merged;
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::unite(const Set& otherSet, Set& result,
+                            std::false_type) const
+{
+    result = *this;
+    result.store.reserve(size() + otherSet.size());
+    for (int i = 0; i < otherSet.size(); i++)
+    {
+        result.store.insert(otherSet.store.at(i));
+    }
+}
+
+template <class T, class Storage>
+Set<T, Storage> Set<T, Storage>::intersect(const Set& otherSet) const
+{
+    Set temp;
+    keep(otherSet, true, temp, std::integral_constant<bool, Storage::ORDERED>());
+    return temp;
+}
+
+template <class T, class Storage>
+Set<T, Storage> Set<T, Storage>::subtract(const Set& otherSet) const
+{
+    Set temp;
+    keep(otherSet, false, temp, std::integral_constant<bool, Storage::ORDERED>());
+    return temp;
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::keep(const Set& otherSet, bool inOther, Set& result,
+                           std::true_type) const
+{
+    // both are in ascending order: one merge-style pass over them
+    T* kept = new T[size() + 1];
+    T* last = inOther
+        ? std::set_intersection(store.begin(), store.end(),
+                                otherSet.store.begin(), otherSet.store.end(),
+                                kept)
+        : std::set_difference(store.begin(), store.end(),
+                              otherSet.store.begin(), otherSet.store.end(),
+                              kept);
+    result.store.assign(kept, last);
+    delete [] kept;
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::keep(const Set& otherSet, bool inOther, Set& result,
+                           std::false_type) const
+{
+    // the elements kept are distinct already, so they are appended
+    // without a search
+    result.store.reserve(inOther && otherSet.size() < size()
+                         ? otherSet.size() : size());
+    for (int i = 0; i < size(); i++)
+    {
+        if (otherSet.contains(store.at(i)) == inOther)
+        {
+            result.store.append(store.at(i));
+        }
+    }
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::reset()
+{
+    store.clear();
+}
+
+template <class T, class Storage>
+bool Set<T, Storage>::add(const T& item)
+{
+    return store.insert(item);
+}
+
+template <class T, class Storage>
+bool Set<T, Storage>::remove(const T& item)
+{
+    return store.erase(item);
+}
+
+template <class T, class Storage>
+void Set<T, Storage>::reserve(int n)
+{
+    store.reserve(n);
+}
+
+template <class T, class Storage>
+bool operator==(const Set<T, Storage>& s1, const Set<T, Storage>& s2)
+{
+    return s1.size() == s2.size() && s1.isSubsetOf(s2);
+}
@@ -0,0 +1,298 @@
+// FILE: Set.h - header file for the Set class template and its
+//       storage policies
+// CLASS TEMPLATES PROVIDED:
+//   Set<T, Storage> (a container class for a set of T values, laid out
+//                    in memory as directed by the storage policy
+//                    Storage)
+//   FixedStorage<T, N>, DynamicStorage<T>, SortedStorage<T>,
+//   HashedStorage<T> (the storage policies)
+//
+// TEMPLATE PARAMETERS
+//   T is the data type of the elements of the set. It may be any of
+//   the C++ built-in types (int, char, etc.), or a class with a
+//   default constructor, an assignment operator, a copy constructor
+//   and operator==; SortedStorage also needs operator<, and
+//   HashedStorage needs std::hash<T>.
+//   Storage is the storage policy. It is fixed at compile time, so the
+//   member functions of Set<T, Storage> call the policy directly (no
+//   virtual functions, no run-time dispatch):
+//     FixedStorage<T, N>   up to N elements held inside the object
+//                          itself (never allocates); linear search.
+//     DynamicStorage<T>    a dynamic array, doubled when full; linear
+//                          search. (This is the default.)
+//     SortedStorage<T>     a dynamic array kept in ascending order;
+//                          binary search, and unionWith, intersect
+//                          and subtract are merges.
+//     HashedStorage<T>     a dynamic array plus an open-addressed hash
+//                          index of it (the index code of IntSet,
+//                          HashIndex.h); O(1) expected search, but
+//                          remove renumbers the elements after the
+//                          one removed.
+//   All four keep elements in order of membership timing (as IntSet
+//   does) except SortedStorage, which keeps them in ascending order.
+//
+// TEMPLATE ALIASES
+//   FixedSet<T, N>, DynamicSet<T>, SortedSet<T>, HashedSet<T>
+//     Set<T, FixedStorage<T, N> >, Set<T, DynamicStorage<T> >, etc.
+//
+// NOTE: IntSet (IntSet.h) is not an alias of a Set<int, ...>: its
+//       users (FrozenIntSet, ParallelSetOps, the views) work on its
+//       entries directly, and it keeps them in one copy-on-write
+//       buffer (entries and index together, from a memory_resource)
+//       with small sets inline, removed entries left in place until
+//       compacted, a sorted flag for the SIMD set kernels and an
+//       order-independent fingerprint. A policy holding all that would
+//       be IntSet itself under another name. Instead, HashedStorage
+//       and IntSet share their hash index code (HashIndex.h), so there
+//       is one copy of it.
+//
+// CONSTRUCTOR
+//   Set()
+//     Pre:  (none)
+//     Post: The invoking Set is initialized to an empty Set.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the invoking Set is returned.
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking Set has no elements,
+//           otherwise false is returned.
+//   bool contains(const T& item) const
+//     Pre:  (none)
+//     Post: true is returned if the invoking Set has item as an
+//           element, otherwise false is returned.
+//   const T& element(int pos) const
+//     Pre:  0 <= pos < size()
+//     Post: The element at position pos of the invoking Set (in the
+//           order kept by the storage policy; see above) is returned.
+//   bool isSubsetOf(const Set& otherSet) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking Set are
+//           also elements of otherSet, otherwise false is returned.
+//           By definition, an empty Set is a subset of any Set.
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: Contents of the invoking Set have been inserted into out
+//           with 2 spaces separating one item from another if there
+//           are 2 or more items.
+//   Set unionWith(const Set& otherSet) const
+//     Pre:  For FixedStorage<T, N>: size() + (# of elements of
+//           otherSet not in the invoking Set) <= N.
+//     Post: A Set representing the union of the invoking Set and
+//           otherSet is returned.
+//   Set intersect(const Set& otherSet) const
+//     Pre:  (none)
+//     Post: A Set representing the intersection of the invoking Set
+//           and otherSet is returned.
+//   Set subtract(const Set& otherSet) const
+//     Pre:  (none)
+//     Post: A Set representing the difference between the invoking
+//           Set and otherSet is returned.
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS)
+//   void reset()
+//     Pre:  (none)
+//     Post: The invoking Set is reset to become an empty Set.
+//   bool add(const T& item)
+//     Pre:  For FixedStorage<T, N>: contains(item) returns true or
+//           size() < N.
+//     Post: If item is not an element of the invoking Set, it has
+//           been added and true is returned; otherwise the Set is
+//           unchanged and false is returned.
+//   bool remove(const T& item)
+//     Pre:  (none)
+//     Post: If item is an element of the invoking Set, it has been
+//           removed and true is returned; otherwise false is
+//           returned.
+//   void reserve(int n)
+//     Pre:  (none)
+//     Post: For the dynamic policies, the invoking Set can hold n
+//           elements without allocating any more memory (FixedStorage
+//           ignores this). The collection is unchanged.
+//
+// NON-MEMBER FUNCTIONS
+//   template <class T, class Storage>
+//   bool operator==(const Set<T, Storage>& s1, const Set<T, Storage>& s2)
+//     Pre:  (none)
+//     Post: True is returned if s1 and s2 have the same elements,
+//           otherwise false is returned.
+//
+// STORAGE POLICY REQUIREMENTS
+//   A storage policy S (for elements of type T) is a class with value
+//   semantics and these members:
+//     static const bool ORDERED      true if elements are kept in
+//                                    ascending order
+//     int size() const               # of elements held
+//     const T& at(int pos) const     element at pos (0 <= pos < size())
+//     bool find(const T& x) const    true if x is held
+//     bool insert(const T& x)        adds x unless held; true if added
+//     void append(const T& x)        adds x, which is not held (and,
+//                                    for an ORDERED policy, is above
+//                                    every element held), without
+//                                    searching for it first
+//     bool erase(const T& x)         removes x if held; true if removed
+//     void clear()                   removes all elements
+//     void reserve(int n)            makes room for n elements
+//   An ORDERED policy also has
+//     const T* begin() const         its elements, in ascending
+//     const T* end() const           order, as a range of pointers
+//     void assign(const T* first, const T* last)
+//                                    holds exactly the (ascending,
+//                                    distinct) values of the range
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may be used with Set objects
+//   (and with the storage policies).
+
+#ifndef SET_H
+#define SET_H
+
+#include <iostream>
+#include <functional>   // provides std::hash
+#include <type_traits>  // provides std::integral_constant
+
+template <class T, int N>
+class FixedStorage
+{
+public:
+   static const bool ORDERED = false;
+   FixedStorage();
+   int size() const;
+   const T& at(int pos) const;
+   bool find(const T& x) const;
+   bool insert(const T& x);
+   void append(const T& x);
+   bool erase(const T& x);
+   void clear();
+   void reserve(int n);
+
+private:
+   T   data[N];
+   int used;
+};
+
+template <class T>
+class DynamicStorage
+{
+public:
+   static const bool ORDERED = false;
+   DynamicStorage();
+   DynamicStorage(const DynamicStorage& src);
+   ~DynamicStorage();
+   DynamicStorage& operator=(const DynamicStorage& rhs);
+   int size() const;
+   const T& at(int pos) const;
+   bool find(const T& x) const;
+   bool insert(const T& x);
+   void append(const T& x);
+   bool erase(const T& x);
+   void clear();
+   void reserve(int n);
+   // low-level access used by the other dynamic policies
+   const T* begin() const;
+   const T* end() const;
+   void insert_at(int pos, const T& x);
+   void erase_at(int pos);
+
+private:
+   T*  data;
+   int capacity;
+   int used;
+};
+
+template <class T>
+class SortedStorage
+{
+public:
+   static const bool ORDERED = true;
+   int size() const;
+   const T& at(int pos) const;
+   bool find(const T& x) const;
+   bool insert(const T& x);
+   void append(const T& x);
+   bool erase(const T& x);
+   void clear();
+   void reserve(int n);
+   const T* begin() const;
+   const T* end() const;
+   void assign(const T* first, const T* last);
+
+private:
+   DynamicStorage<T> items;
+   int lowerBound(const T& x) const;
+};
+
+template <class T>
+class HashedStorage
+{
+public:
+   static const bool ORDERED = false;
+   HashedStorage();
+   HashedStorage(const HashedStorage& src);
+   ~HashedStorage();
+   HashedStorage& operator=(const HashedStorage& rhs);
+   int size() const;
+   const T& at(int pos) const;
+   bool find(const T& x) const;
+   bool insert(const T& x);
+   void append(const T& x);
+   bool erase(const T& x);
+   void clear();
+   void reserve(int n);
+
+private:
+   DynamicStorage<T> items;
+   int* index;         // slots hold position + 1 (0 is an empty slot)
+   int  indexBits;
+   static unsigned hashOf(const T& x);
+   int findSlot(const T& x) const;
+   void rebuildIndex(int bits);
+};
+
+template <class T, class Storage = DynamicStorage<T> >
+class Set
+{
+public:
+   typedef T value_type;
+   typedef Storage storage_type;
+   Set();
+   int size() const;
+   bool isEmpty() const;
+   bool contains(const T& item) const;
+   const T& element(int pos) const;
+   bool isSubsetOf(const Set& otherSet) const;
+   void DumpData(std::ostream& out) const;
+   Set unionWith(const Set& otherSet) const;
+   Set intersect(const Set& otherSet) const;
+   Set subtract(const Set& otherSet) const;
+   void reset();
+   bool add(const T& item);
+   bool remove(const T& item);
+   void reserve(int n);
+
+private:
+   Storage store;
+   void unite(const Set& otherSet, Set& result, std::true_type) const;
+   void unite(const Set& otherSet, Set& result, std::false_type) const;
+   void keep(const Set& otherSet, bool inOther, Set& result,
+             std::true_type) const;
+   void keep(const Set& otherSet, bool inOther, Set& result,
+             std::false_type) const;
+};
+
+template <class T, class Storage>
+bool operator==(const Set<T, Storage>& s1, const Set<T, Storage>& s2);
+
+template <class T, int N>
+using FixedSet = Set<T, FixedStorage<T, N> >;
+template <class T>
+using DynamicSet = Set<T, DynamicStorage<T> >;
+template <class T>
+using SortedSet = Set<T, SortedStorage<T> >;
+template <class T>
+using HashedSet = Set<T, HashedStorage<T> >;
+
+#include "Set.cpp"
+#endif
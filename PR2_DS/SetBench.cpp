@@ -0,0 +1,136 @@
+// FILE: SetBench.cpp
+//       A non-interactive benchmark program comparing the storage
+//       policies of Set<T, Storage> (and IntSet) across set sizes.
+//
+// USAGE: ./a2setbench [n]
+//        where n is the largest set size timed (default 16384); sizes
+//        16, 64, 256, ... up to n are timed. The linear-search
+//        policies are only timed up to 2048 (FixedSet) or 4096
+//        (DynamicSet) elements, where they are already far behind.
+// NOTE: The Set templates are compiled into this program with -O2,
+//       while IntSet.o is built without optimization (as for a2), so
+//       the IntSet line is only a rough reference point.
+
+#include "Set.h"
+#include "IntSet.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+
+// PROTOTYPES for functions used by this benchmark program:
+
+template <class SetType>
+void bench_policy(const char name[], int n);
+// Pre:  n > 0; SetType can hold 2 * n elements.
+// Post: add, contains, remove, unionWith, intersect and subtract on
+//       SetType sets of n pseudo-random elements have been timed and
+//       a line giving the millions of elements processed per second
+//       for each has been written to cout.
+
+double seconds_since(clock_t start);
+// Pre:  start was obtained from clock().
+// Post: The CPU time (in seconds) elapsed since start is returned.
+
+int main(int argc, char* argv[])
+{
+   int maxN = 16384;
+   if (argc > 1)
+      maxN = atoi(argv[1]);
+   if (maxN < 16)
+      maxN = 16;
+
+   cout << "Million elements per second for:" << endl
+        << "   " << left << setw(22) << "" << right
+        << "      add contains   remove    union intersect subtract" << endl;
+   for (int n = 16; n <= maxN; n *= 4)
+   {
+      cout << n << " elements:" << endl;
+      if (n <= 2048)
+         bench_policy< FixedSet<int, 4096> >("FixedSet<int, 4096>", n);
+      if (n <= 4096)
+         bench_policy< DynamicSet<int> >("DynamicSet<int>", n);
+      bench_policy< SortedSet<int> >("SortedSet<int>", n);
+      bench_policy< HashedSet<int> >("HashedSet<int>", n);
+      bench_policy< IntSet >("IntSet", n);
+   }
+   return EXIT_SUCCESS;
+}
+
+double seconds_since(clock_t start)
+{
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+template <class SetType>
+void bench_policy(const char name[], int n)
+{
+   // enough repetitions for about 4 million elements per operation
+   int reps = 4000000 / n;
+   if (reps < 1)
+      reps = 1;
+   if (n > 256 && reps > 64)
+      reps = 64;
+
+   int* values = new int[2 * n];
+   unsigned seed = 2017u;
+   for (int i = 0; i < 2 * n; ++i)
+   {
+      seed = seed * 1103515245u + 12345u;
+      values[i] = int(seed >> 4) % (3 * n);
+   }
+
+   double rate[6];
+   long check = 0;
+   clock_t start;
+
+   SetType a, b;
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+   {
+      a.reset();
+      for (int i = 0; i < n; ++i)
+         a.add(values[i]);
+   }
+   rate[0] = double(n) * reps / seconds_since(start);
+   for (int i = n; i < 2 * n; ++i)
+      b.add(values[i]);
+
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+      for (int i = n / 2; i < n + n / 2; ++i)
+         check += a.contains(values[i]);
+   rate[1] = double(n) * reps / seconds_since(start);
+
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+   {
+      SetType c(a);
+      for (int i = 0; i < n; ++i)
+         check += c.remove(values[i]);
+   }
+   rate[2] = double(n) * reps / seconds_since(start);
+
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+      check += a.unionWith(b).size();
+   rate[3] = double(a.size() + b.size()) * reps / seconds_since(start);
+
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+      check += a.intersect(b).size();
+   rate[4] = double(a.size() + b.size()) * reps / seconds_since(start);
+
+   start = clock();
+   for (int r = 0; r < reps; ++r)
+      check += a.subtract(b).size();
+   rate[5] = double(a.size() + b.size()) * reps / seconds_since(start);
+
+   cout << "   " << left << setw(22) << name << right << fixed
+        << setprecision(1);
+   for (int k = 0; k < 6; ++k)
+      cout << setw(9) << rate[k] / 1e6;
+   cout << "   (" << check % 1000 << ")" << endl;
+   delete [] values;
+}
@@ -0,0 +1,240 @@
+// FILE: SetKernels.cpp
+//       Implementation file for the sorted-array set kernels
+//       (See SetKernels.h for documentation.)
+//
+// The vector versions follow the usual shuffle-based block scheme:
+// a block of a (4 values for SSE, 8 for AVX2) is compared against a
+// block of b in all rotations of the b block, which yields a bitmask
+// of the a values that have a match; the matching (or, for subtract,
+// the non-matching) values are then packed to the front of a register
+// with a shuffle looked up from a table indexed by the bitmask, and
+// the whole register is stored at the output position. Whichever
+// block has the smaller last value is then retired (both are retired
+// when the last values are equal). The values left over at the end
+// (fewer than a whole block in a or b) are handled by the scalar code.
+//
+// NOTE: Since the whole register is stored each time, up to a block's
+//       worth of values past the last value written may be touched.
+//       For subtract this never goes past the room required by the
+//       preconditions (values are only written when their block of a
+//       is retired); for intersect the values of a block can be written
+//       a few at a time, so the last few are stored one by one when a
+//       whole register would not fit.
+
+#include "SetKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace
+{
+   // Tables of shuffle controls that move the values selected by a
+   // bitmask to the front of a register (in their original order).
+   struct ShuffleTables
+   {
+#if defined(__AVX2__)
+      int avx[256][8];
+#elif defined(__SSSE3__)
+      unsigned char sse[16][16];
+#endif
+      ShuffleTables()
+      {
+#if defined(__AVX2__)
+         for (int mask = 0; mask < 256; ++mask)
+         {
+            int k = 0;
+            for (int lane = 0; lane < 8; ++lane)
+               if (mask & (1 << lane))
+                  avx[mask][k++] = lane;
+            while (k < 8)
+               avx[mask][k++] = 0;
+         }
+#elif defined(__SSSE3__)
+         for (int mask = 0; mask < 16; ++mask)
+         {
+            int k = 0;
+            for (int lane = 0; lane < 4; ++lane)
+               if (mask & (1 << lane))
+               {
+                  for (int byte = 0; byte < 4; ++byte)
+                     sse[mask][k * 4 + byte] = (unsigned char)(lane * 4 + byte);
+                  ++k;
+               }
+            for (int byte = k * 4; byte < 16; ++byte)
+               sse[mask][byte] = 0x80;
+         }
+#endif
+      }
+   };
+
+   const ShuffleTables tables;
+
+   int scalarIntersect(const int* a, int na, const int* b, int nb, int* out)
+   {
+      int i = 0, j = 0, k = 0;
+      while (i < na && j < nb)
+      {
+         if (a[i] < b[j])
+            ++i;
+         else if (b[j] < a[i])
+            ++j;
+         else
+         {
+            out[k++] = a[i];
+            ++i;
+            ++j;
+         }
+      }
+      return k;
+   }
+
+   // Scalar difference of a[i..na-1] and b[j..nb-1] written to out[k..];
+   // values of the block starting at a[i] whose bit is set in found are
+   // known to be in b already and are skipped. Returns the new k.
+   int scalarSubtract(const int* a, int i, int na, const int* b, int j,
+                      int nb, int* out, int k, int found)
+   {
+      for (int t = i; t < na; ++t)
+      {
+         if (t - i < 8 && ((found >> (t - i)) & 1))
+            continue;
+         while (j < nb && b[j] < a[t])
+            ++j;
+         if (j == nb || b[j] != a[t])
+            out[k++] = a[t];
+      }
+      return k;
+   }
+
+#if defined(__AVX2__)
+   inline int matchMask(__m256i va, __m256i vb)
+   {
+      const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+      __m256i hits = _mm256_cmpeq_epi32(va, vb);
+      for (int r = 1; r < 8; ++r)
+      {
+         vb = _mm256_permutevar8x32_epi32(vb, rotate);
+         hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(va, vb));
+      }
+      return _mm256_movemask_ps(_mm256_castsi256_ps(hits));
+   }
+
+   inline int storeSelected(__m256i va, int mask, int* out)
+   {
+      __m256i control = _mm256_loadu_si256((const __m256i*)tables.avx[mask]);
+      _mm256_storeu_si256((__m256i*)out, _mm256_permutevar8x32_epi32(va, control));
+      return __builtin_popcount(mask);
+   }
+#elif defined(__SSSE3__)
+   inline int matchMask(__m128i va, __m128i vb)
+   {
+      __m128i hits = _mm_cmpeq_epi32(va, vb);
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+      return _mm_movemask_ps(_mm_castsi128_ps(hits));
+   }
+
+   inline int storeSelected(__m128i va, int mask, int* out)
+   {
+      __m128i control = _mm_loadu_si128((const __m128i*)tables.sse[mask]);
+      _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(va, control));
+      return __builtin_popcount(mask);
+   }
+#endif
+
+#if defined(__AVX2__)
+   typedef __m256i block_type;
+   const int BLOCK = 8;
+   inline block_type loadBlock(const int* p)
+   { return _mm256_loadu_si256((const __m256i*)p); }
+#elif defined(__SSSE3__)
+   typedef __m128i block_type;
+   const int BLOCK = 4;
+   inline block_type loadBlock(const int* p)
+   { return _mm_loadu_si128((const __m128i*)p); }
+#endif
+}
+
+int sortedIntersect(const int* a, int na, const int* b, int nb, int* out)
+{
+   int i = 0, j = 0, k = 0;
+#if defined(__AVX2__) || defined(__SSSE3__)
+   const int room = (na < nb) ? na : nb;
+   while (i + BLOCK <= na && j + BLOCK <= nb)
+   {
+      int mask = matchMask(loadBlock(a + i), loadBlock(b + j));
+      if (mask != 0)
+      {
+         if (k + BLOCK <= room)
+            k += storeSelected(loadBlock(a + i), mask, out + k);
+         else
+            for (int lane = 0; lane < BLOCK; ++lane)
+               if (mask & (1 << lane))
+                  out[k++] = a[i + lane];
+      }
+      int aLast = a[i + BLOCK - 1],
+          bLast = b[j + BLOCK - 1];
+      if (aLast <= bLast)
+         i += BLOCK;
+      if (bLast <= aLast)
+         j += BLOCK;
+   }
+#endif
+   return k + scalarIntersect(a + i, na - i, b + j, nb - j, out + k);
+}
+
+int sortedUnion(const int* a, int na, const int* b, int nb, int* out)
+{
+   int i = 0, j = 0, k = 0;
+   while (i < na && j < nb)
+   {
+      int x = a[i], y = b[j];
+      out[k++] = (x <= y) ? x : y;
+      i += (x <= y);
+      j += (y <= x);
+   }
+   while (i < na)
+      out[k++] = a[i++];
+   while (j < nb)
+      out[k++] = b[j++];
+   return k;
+}
+
+int sortedSubtract(const int* a, int na, const int* b, int nb, int* out)
+{
+   int i = 0, j = 0, k = 0, found = 0;
+#if defined(__AVX2__) || defined(__SSSE3__)
+   const int ALL = (1 << BLOCK) - 1;
+   while (i + BLOCK <= na && j + BLOCK <= nb)
+   {
+      found |= matchMask(loadBlock(a + i), loadBlock(b + j));
+      int aLast = a[i + BLOCK - 1],
+          bLast = b[j + BLOCK - 1];
+      if (aLast <= bLast)
+      {
+         if (found != ALL)
+            k += storeSelected(loadBlock(a + i), ALL & ~found, out + k);
+         i += BLOCK;
+         found = 0;
+      }
+      if (bLast <= aLast)
+         j += BLOCK;
+   }
+#endif
+   return scalarSubtract(a, i, na, b, j, nb, out, k, found);
+}
+
+const char* setKernelsName()
+{
+#if defined(__AVX2__)
+   return "avx2";
+#elif defined(__SSSE3__)
+   return "sse4";
+#else
+   return "scalar";
+#endif
+}
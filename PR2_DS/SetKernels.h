@@ -0,0 +1,51 @@
+// FILE: SetKernels.h - header file for the sorted-array set kernels
+// FUNCTIONS PROVIDED: set algebra on sorted arrays of distinct int
+//                     values (used by IntSet when both operands are
+//                     in sorted form)
+//
+// NOTE ON INSTRUCTION SETS
+//   The kernels are selected at compile time: an AVX2 version is used
+//   when the translation unit is compiled with AVX2 enabled (__AVX2__),
+//   otherwise an SSSE3/SSE4 version when SSSE3 is enabled (__SSSE3__),
+//   otherwise a portable scalar version. All versions produce exactly
+//   the same output.
+//
+// FUNCTIONS
+//   int sortedIntersect(const int* a, int na, const int* b, int nb,
+//                       int* out)
+//     Pre:  a[0..na-1] and b[0..nb-1] are each strictly ascending;
+//           out has room for at least min(na, nb) values and does not
+//           overlap a or b.
+//     Post: The values common to a and b have been written in
+//           ascending order to out[0], out[1], ...; the # of values
+//           written is returned.
+//   int sortedUnion(const int* a, int na, const int* b, int nb,
+//                   int* out)
+//     Pre:  a[0..na-1] and b[0..nb-1] are each strictly ascending;
+//           out has room for at least na + nb values and does not
+//           overlap a or b.
+//     Post: The values that are in a or b (or both) have been written
+//           in ascending order to out[0], out[1], ...; the # of values
+//           written is returned.
+//   int sortedSubtract(const int* a, int na, const int* b, int nb,
+//                      int* out)
+//     Pre:  a[0..na-1] and b[0..nb-1] are each strictly ascending;
+//           out has room for at least na values and does not overlap
+//           a or b.
+//     Post: The values of a that are not in b have been written in
+//           ascending order to out[0], out[1], ...; the # of values
+//           written is returned.
+//   const char* setKernelsName()
+//     Pre:  (none)
+//     Post: The name of the instruction set the kernels were compiled
+//           for ("avx2", "sse4" or "scalar") is returned.
+
+#ifndef SET_KERNELS_H
+#define SET_KERNELS_H
+
+int sortedIntersect(const int* a, int na, const int* b, int nb, int* out);
+int sortedUnion(const int* a, int na, const int* b, int nb, int* out);
+int sortedSubtract(const int* a, int na, const int* b, int nb, int* out);
+const char* setKernelsName();
+
+#endif
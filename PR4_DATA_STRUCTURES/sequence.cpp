@@ -4,13 +4,19 @@
 //   1. The number of items in the sequence is in the member variable
 //      used;
 //   2. The actual items of the sequence are stored in a partially
-//      filled array. The array is a compile-time array whose size
-//      is fixed at CAPACITY; the  member variable data references
-//      the array.
-//   3. For an empty sequence, we do not care what is stored in any
-//      of data; for a non-empty sequence the items in the sequence
-//      are stored in data[0] through data[used-1], and we don't care
-//      what's in the rest of data.
+//      filled circular buffer. The buffer is a dynamic array of
+//      allocated slots (raw memory got from operator new, or a null
+//      pointer if allocated is 0); the member variable data points to
+//      it. The factor by which it grows when full is in the member
+//      variable growth.
+//   3. The slot of the first item is in the member variable head
+//      (head < allocated, or head is 0 if allocated is 0), and item i
+//      is in the slot after that of item i - 1, the slot after
+//      data[allocated-1] being data[0]: item i is data[slot(i)]. For a
+//      non-empty sequence items are constructed in the slots of items
+//      0 through used-1; no object lives in the rest of the slots (so
+//      items are constructed with placement new when added, and
+//      destroyed explicitly when removed).
 //   4. The index of the current item is in the member variable
 //      current_index. If there is no valid current item, then
 //      current item will be set to the same number as used.
@@ -37,14 +43,113 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//
+// DOCUMENTATION for private member (helper) functions:
+//   size_type slot(size_type index) const
+//     Pre:  index < allocated
+//     Post: The index of the slot of data that item index is (or would
+//           be) in is returned.
+//   T& item(size_type index)
+//     Pre:  index < used
+//     Post: Item index is returned.
+//   void shift(size_type to, size_type from, size_type count)
+//     Pre:  Items from through from + count - 1 are constructed, and so
+//           are the slots of items to through to + count - 1 (and
+//           to + count, from + count <= allocated).
+//     Post: As for move_items, for items from through from + count - 1
+//           moved to to through to + count - 1; each run of them that
+//           is contiguous in data at both ends is moved by one call to
+//           move_items (there are at most three runs).
+//   void relocate_out(T* dest, size_type index, size_type count)
+//     Pre:  Items index through index + count - 1 are constructed, and
+//           dest points to count slots of raw memory outside data.
+//     Post: As for relocate, for those items relocated to dest[0]
+//           through dest[count-1], in order.
+//   void destroy_items(size_type index, size_type count)
+//     Pre:  Items index through index + count - 1 are constructed.
+//     Post: Those items have been destroyed.
+//   static T* allocate(size_type n)
+//     Pre:  (none)
+//     Post: Raw memory for n items is returned (a null pointer if n is
+//           0); no item has been constructed in it.
+//   static void relocate(T* dest, T* source, size_type count)
+//     Pre:  source points to count items and dest to count slots of raw
+//           memory (the two do not overlap).
+//     Post: An item has been constructed in each slot from the item
+//           source pointed to (from std::move_if_noexcept of it; with
+//           one memcpy for a trivially copyable T); the items at source
+//           are still there to be destroyed. If a constructor throws,
+//           the items made so far have been destroyed before the
+//           exception is passed on.
+//   static void destroy(T* items, size_type count)
+//     Pre:  items points to count items.
+//     Post: The count items have been destroyed (their memory is left
+//           as raw slots).
+//   static void move_items(T* dest, T* source, size_type count)
+//     Pre:  dest and source each point to count items (the two runs may
+//           overlap).
+//     Post: The items source pointed to have been moved, in order, to
+//           dest (as though through a temporary array); the items left
+//           behind at source are valid but unspecified. For a
+//           trivially copyable T (chosen at compile time) this is one
+//           memmove; otherwise each item is move-assigned in turn, in
+//           the direction that does not overwrite items not yet moved.
 
 #include <cassert>
+#include <cstring>      // provides memcpy, memmove
+#include <new>          // provides placement new
+#include <utility>      // provides move, move_if_noexcept, forward, swap
 #include "sequence.h"
 
 namespace CS3358_FA17_A04
 {
    template <class T>
-   sequence<T>::sequence() : used(0), current_index(0) { }
+   sequence<T>::sequence(size_type initial_capacity, double growth)
+      : data(allocate(initial_capacity)), used(0), current_index(0),
+        allocated(initial_capacity), head(0), growth(growth)
+   {
+      assert( growth > 1 );
+   }
+
+   template <class T>
+   sequence<T>::sequence(const sequence& source)
+      : data(allocate(source.allocated)), used(0),
+        current_index(source.current_index), allocated(source.allocated),
+        head(0), growth(source.growth)
+   {
+      try
+      {
+         for ( ; used < source.used; ++used)
+            ::new (static_cast<void*>(data + used))
+               T(source.data[source.slot(used)]);
+      }
+      catch (...)
+      {
+         destroy(data, used);
+         ::operator delete(data);
+         throw;
+      }
+   }
+
+   template <class T>
+   sequence<T>::sequence(sequence&& source) noexcept
+      : data(source.data), used(source.used),
+        current_index(source.current_index), allocated(source.allocated),
+        head(source.head), growth(source.growth)
+   {
+      source.data = nullptr;
+      source.used = 0;
+      source.current_index = 0;
+      source.allocated = 0;
+      source.head = 0;
+   }
+
+   template <class T>
+   sequence<T>::~sequence()
+   {
+      destroy_items(0, used);
+      ::operator delete(data);
+   }
 
    template <class T>
    void sequence<T>::start() { current_index = 0; }
@@ -71,27 +176,79 @@ namespace CS3358_FA17_A04
    }
 
    template <class T>
-   void sequence<T>::add(const T& entry)
-   {
-      assert( size() < CAPACITY );
+   void sequence<T>::add(const T& entry) { emplace(entry); }
 
-      size_type i;
+   template <class T>
+   void sequence<T>::add(T&& entry) { emplace(std::move(entry)); }
+
+   template <class T>
+   template <class... Args>
+   void sequence<T>::emplace(Args&&... args)
+   {
+      size_type index = is_item() ? current_index + 1 : 0;
 
-      if ( ! is_item() )
+      if (used == allocated)
+      {
+         // build the new item in the larger array first, then move
+         // the others in around it (the new array starts at slot 0)
+         size_type new_allocated = size_type(allocated * growth);
+         if (new_allocated <= used)
+            new_allocated = used + 1;
+         T* temp = allocate(new_allocated);
+         int stage = 0;     // # of the three steps below done
+         try
+         {
+            ::new (static_cast<void*>(temp + index))
+               T(std::forward<Args>(args)...);
+            stage = 1;
+            relocate_out(temp, 0, index);
+            stage = 2;
+            relocate_out(temp + index + 1, index, used - index);
+         }
+         catch (...)
+         {
+            if (stage >= 1)
+               destroy(temp + index, 1);
+            if (stage == 2)
+               destroy(temp, index);
+            ::operator delete(temp);
+            throw;
+         }
+         destroy_items(0, used);
+         ::operator delete(data);
+         data = temp;
+         allocated = new_allocated;
+         head = 0;
+      }
+      else if (index == used)
+         ::new (static_cast<void*>(data + slot(used)))
+            T(std::forward<Args>(args)...);
+      else if (index == 0)
+      {
+         size_type new_head = (head == 0) ? allocated - 1 : head - 1;
+         ::new (static_cast<void*>(data + new_head))
+            T(std::forward<Args>(args)...);
+         head = new_head;
+      }
+      else if (index < used - index)
       {
-         if (used > 0)
-            for (i = used; i >= 1; --i)
-               data[i] = data[i - 1];
-         data[0] = entry;
-         current_index = 0;
+         // fewer items before the new one: move those down a slot
+         T entry(std::forward<Args>(args)...);
+         size_type new_head = (head == 0) ? allocated - 1 : head - 1;
+         ::new (static_cast<void*>(data + new_head)) T(std::move(data[head]));
+         head = new_head;
+         shift(1, 2, index - 1);
+         item(index) = std::move(entry);
       }
       else
       {
-         ++current_index;
-         for (i = used; i > current_index; --i)
-            data[i] = data[i - 1];
-         data[current_index] = entry;
+         T entry(std::forward<Args>(args)...);
+         ::new (static_cast<void*>(data + slot(used)))
+            T(std::move(item(used - 1)));
+         shift(index + 1, index, used - index - 1);
+         item(index) = std::move(entry);
       }
+      current_index = index;
       ++used;
    }
 
@@ -100,13 +257,77 @@ namespace CS3358_FA17_A04
    {
       assert( is_item() );
 
-      size_type i;
-
-      for (i = current_index + 1; i < used; ++i)
-         data[i - 1] = data[i];
+      if (current_index < used - current_index - 1)
+      {
+         // fewer items before the current one: move those up a slot
+         shift(1, 0, current_index);
+         destroy(data + head, 1);
+         head = slot(1);
+      }
+      else
+      {
+         shift(current_index, current_index + 1, used - current_index - 1);
+         destroy(data + slot(used - 1), 1);
+      }
       --used;
    }
 
+   template <class T>
+   void sequence<T>::reserve(size_type new_capacity)
+   {
+      if (new_capacity <= allocated)
+         return;
+
+      T* temp = allocate(new_capacity);
+      try
+      {
+         relocate_out(temp, 0, used);
+      }
+      catch (...)
+      {
+         ::operator delete(temp);
+         throw;
+      }
+      destroy_items(0, used);
+      ::operator delete(data);
+      data = temp;
+      allocated = new_capacity;
+      head = 0;
+   }
+
+   template <class T>
+   void sequence<T>::swap(sequence& other) noexcept
+   {
+      std::swap(data, other.data);
+      std::swap(used, other.used);
+      std::swap(current_index, other.current_index);
+      std::swap(allocated, other.allocated);
+      std::swap(head, other.head);
+      std::swap(growth, other.growth);
+   }
+
+   template <class T>
+   sequence<T>& sequence<T>::operator=(const sequence& source)
+   {
+      if (this != &source)
+      {
+         sequence temp(source);
+         swap(temp);
+      }
+      return *this;
+   }
+
+   template <class T>
+   sequence<T>& sequence<T>::operator=(sequence&& source) noexcept
+   {
+      if (this != &source)
+      {
+         sequence temp(std::move(source));
+         swap(temp);
+      }
+      return *this;
+   }
+
    template <class T>
    typename sequence<T>::size_type sequence<T>::size() const { return used; }
 
@@ -118,6 +339,311 @@ namespace CS3358_FA17_A04
    {
       assert( is_item() );
 
-      return data[current_index];
+      return data[slot(current_index)];
+   }
+
+   template <class T>
+   typename sequence<T>::size_type sequence<T>::capacity() const
+   { return allocated; }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::begin() const
+   { return const_iterator(this, 0); }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::end() const
+   { return const_iterator(this, used); }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::cbegin() const
+   { return begin(); }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::cend() const
+   { return end(); }
+
+   template <class T>
+   typename sequence<T>::item_range sequence<T>::items() const
+   { return item_range(this); }
+
+   template <class T>
+   sequence<T>::item_range::item_range(const sequence* owner) : seq(owner) { }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::item_range::begin() const
+   { return seq->begin(); }
+
+   template <class T>
+   typename sequence<T>::const_iterator sequence<T>::item_range::end() const
+   { return seq->end(); }
+
+   template <class T>
+   sequence<T>::const_iterator::const_iterator() : seq(nullptr), pos(0) { }
+
+   template <class T>
+   sequence<T>::const_iterator::const_iterator(const sequence* owner,
+                                               size_type start)
+      : seq(owner), pos(start) { }
+
+   template <class T>
+   typename sequence<T>::const_iterator::reference
+   sequence<T>::const_iterator::operator*() const
+   { return seq->data[seq->slot(pos)]; }
+
+   template <class T>
+   typename sequence<T>::const_iterator::pointer
+   sequence<T>::const_iterator::operator->() const
+   { return seq->data + seq->slot(pos); }
+
+   template <class T>
+   typename sequence<T>::const_iterator::reference
+   sequence<T>::const_iterator::operator[](difference_type n) const
+   { return seq->data[seq->slot(pos + n)]; }
+
+   template <class T>
+   typename sequence<T>::const_iterator&
+   sequence<T>::const_iterator::operator++()
+   {
+      ++pos;
+      return *this;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator
+   sequence<T>::const_iterator::operator++(int)
+   {
+      const_iterator before = *this;
+      ++pos;
+      return before;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator&
+   sequence<T>::const_iterator::operator--()
+   {
+      --pos;
+      return *this;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator
+   sequence<T>::const_iterator::operator--(int)
+   {
+      const_iterator before = *this;
+      --pos;
+      return before;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator&
+   sequence<T>::const_iterator::operator+=(difference_type n)
+   {
+      pos += n;
+      return *this;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator&
+   sequence<T>::const_iterator::operator-=(difference_type n)
+   {
+      pos -= n;
+      return *this;
+   }
+
+   template <class T>
+   typename sequence<T>::const_iterator
+   sequence<T>::const_iterator::operator+(difference_type n) const
+   { return const_iterator(seq, pos + n); }
+
+   template <class T>
+   typename sequence<T>::const_iterator
+   sequence<T>::const_iterator::operator-(difference_type n) const
+   { return const_iterator(seq, pos - n); }
+
+   template <class T>
+   typename sequence<T>::const_iterator::difference_type
+   sequence<T>::const_iterator::operator-(const const_iterator& rhs) const
+   { return difference_type(pos) - difference_type(rhs.pos); }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator==(const const_iterator& rhs) const
+   { return pos == rhs.pos && seq == rhs.seq; }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator!=(const const_iterator& rhs) const
+   { return !(*this == rhs); }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator<(const const_iterator& rhs) const
+   { return pos < rhs.pos; }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator>(const const_iterator& rhs) const
+   { return rhs.pos < pos; }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator<=(const const_iterator& rhs) const
+   { return !(rhs.pos < pos); }
+
+   template <class T>
+   bool sequence<T>::const_iterator::operator>=(const const_iterator& rhs) const
+   { return !(pos < rhs.pos); }
+
+   template <class T>
+   typename sequence<T>::size_type sequence<T>::slot(size_type index) const
+   {
+      // head < allocated and index < allocated, so one wrap at most
+      return (index < allocated - head) ? head + index
+                                        : index - (allocated - head);
+   }
+
+   template <class T>
+   T& sequence<T>::item(size_type index) { return data[slot(index)]; }
+
+   template <class T>
+   void sequence<T>::shift(size_type to, size_type from, size_type count)
+   {
+      size_type run;
+
+      if (to < from)
+         // moving toward the front: from the first items on
+         while (count > 0)
+         {
+            size_type dest = slot(to), source = slot(from);
+            run = count;
+            if (allocated - dest < run)
+               run = allocated - dest;
+            if (allocated - source < run)
+               run = allocated - source;
+            move_items(data + dest, data + source, run);
+            to += run;
+            from += run;
+            count -= run;
+         }
+      else
+         // moving toward the back: from the last items on
+         while (count > 0)
+         {
+            size_type dest_end = slot(to + count - 1) + 1,
+                      source_end = slot(from + count - 1) + 1;
+            run = count;
+            if (dest_end < run)
+               run = dest_end;
+            if (source_end < run)
+               run = source_end;
+            move_items(data + dest_end - run, data + source_end - run, run);
+            count -= run;
+         }
+   }
+
+   template <class T>
+   void sequence<T>::relocate_out(T* dest, size_type index, size_type count)
+   {
+      if (count == 0)
+         return;
+
+      size_type first = slot(index);
+      size_type run = (allocated - first < count) ? allocated - first : count;
+      relocate(dest, data + first, run);
+      try
+      {
+         relocate(dest + run, data, count - run);
+      }
+      catch (...)
+      {
+         destroy(dest, run);
+         throw;
+      }
+   }
+
+   template <class T>
+   void sequence<T>::destroy_items(size_type index, size_type count)
+   {
+      if (count == 0)
+         return;
+
+      size_type first = slot(index);
+      size_type run = (allocated - first < count) ? allocated - first : count;
+      destroy(data + first, run);
+      destroy(data, count - run);
+   }
+
+   template <class T>
+   T* sequence<T>::allocate(size_type n)
+   {
+      if (n == 0)
+         return nullptr;
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+   }
+
+   template <class T>
+   void sequence<T>::relocate(T* dest, T* source, size_type count)
+   {
+      relocate(dest, source, count,
+               typename std::is_trivially_copyable<T>::type());
+   }
+
+   template <class T>
+   void sequence<T>::relocate(T* dest, T* source, size_type count,
+                              std::true_type)
+   {
+      if (count > 0)
+         std::memcpy(dest, source, count * sizeof(T));
+   }
+
+   template <class T>
+   void sequence<T>::relocate(T* dest, T* source, size_type count,
+                              std::false_type)
+   {
+      size_type i = 0;
+
+      try
+      {
+         for ( ; i < count; ++i)
+            ::new (static_cast<void*>(dest + i))
+               T(std::move_if_noexcept(source[i]));
+      }
+      catch (...)
+      {
+         destroy(dest, i);
+         throw;
+      }
+   }
+
+   template <class T>
+   void sequence<T>::destroy(T* items, size_type count)
+   {
+      size_type i;
+
+      for (i = 0; i < count; ++i)
+         items[i].~T();
+   }
+
+   template <class T>
+   void sequence<T>::move_items(T* dest, T* source, size_type count)
+   {
+      move_items(dest, source, count,
+                 typename std::is_trivially_copyable<T>::type());
+   }
+
+   template <class T>
+   void sequence<T>::move_items(T* dest, T* source, size_type count,
+                                std::true_type)
+   {
+      std::memmove(dest, source, count * sizeof(T));
+   }
+
+   template <class T>
+   void sequence<T>::move_items(T* dest, T* source, size_type count,
+                                std::false_type)
+   {
+      size_type i;
+
+      if (dest < source)
+         for (i = 0; i < count; ++i)
+            dest[i] = std::move(source[i]);
+      else
+         for (i = count; i > 0; --i)
+            dest[i - 1] = std::move(source[i - 1]);
    }
 }
@@ -4,22 +4,44 @@
 //                 where each list may have a designated item called
 //                 the current item)
 //
+//   The items are kept in a circular buffer, so adding an item at the
+//   front or the back of the sequence, and removing its first or last
+//   item, takes O(1) time (add and emplace may have to grow the buffer
+//   first, which makes them O(1) amortized); elsewhere, only the items
+//   on the shorter side of the place are shifted.
+//
 // TEMPLATE PARAMETER, TYPEDEFS, MEMBER CONSTANTS for the sequence<T> class:
 //     The template parameter, T,is the data type of the items in the sequence.
 //     It may be any of the C++ built-in types (int, char, etc.), or a
-//     class with a default constructor, an assignment operator, and a
-//     copy constructor.
+//     class with a copy (or move) constructor and a copy (or move)
+//     assignment operator; no default constructor is needed.
 //   typedef ____ size_type
 //     sequence::size_type is the data type of any variable that keeps
 //     track of how many items are in a sequence.
-//   static const size_type CAPACITY = _____
-//     sequence::CAPACITY is the maximum number of items that a
-//     sequence can hold.
+//   static const size_type DEFAULT_CAPACITY = _____
+//     sequence::DEFAULT_CAPACITY is the initial capacity of a sequence
+//     that is created by the default constructor.
+//   static constexpr double DEFAULT_GROWTH = _____
+//     sequence::DEFAULT_GROWTH is the factor by which a full sequence
+//     grows its capacity unless another is given to the constructor.
 //
-// CONSTRUCTOR for the sequence<T> class:
-//   sequence()
+// CONSTRUCTORS for the sequence<T> class:
+//   sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//            double growth = DEFAULT_GROWTH)
+//     Pre:  growth > 1.
+//     Post: The sequence has been initialized as an empty sequence
+//           with room for initial_capacity items. Whenever an add or
+//           emplace finds it full, its capacity is multiplied by growth
+//           (but grows by at least one item).
+//   sequence(const sequence& source)
+//     Pre:  (none)
+//     Post: The sequence is a copy of source (items, current item,
+//           capacity and growth).
+//   sequence(sequence&& source) noexcept
 //     Pre:  (none)
-//     Post: The sequence has been initialized as an empty sequence.
+//     Post: The sequence has taken over the items (and current item,
+//           capacity and growth) of source, without copying any of
+//           them; source is left an empty sequence with no capacity.
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void start()
@@ -42,18 +64,41 @@
 //           there is no longer any current item. Otherwise, the new current
 //           item is the item immediately before the original current item.
 //   void add(const T& entry)
-//     Pre:  size() < CAPACITY.
-//     Post: A new copy of entry has been inserted in the sequence after
-//           the current item. If there was no current item, then the new
-//           entry has been inserted as new first item of the sequence. In
-//           either case, the newly added item is now the current item of
-//           the sequence.
+//   void add(T&& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry (moved from entry, for an rvalue) has
+//           been inserted in the sequence after the current item. If
+//           there was no current item, then the new entry has been
+//           inserted as new first item of the sequence. In either case,
+//           the newly added item is now the current item of the sequence.
+//   template <class... Args> void emplace(Args&&... args)
+//     Pre:  (none)
+//     Post: As for add, except that the new item has been constructed
+//           in place from args (as T(args...)).
+//     Note: When the sequence is full, add and emplace grow it by the
+//           growth factor, moving the items to the new array (with
+//           std::move_if_noexcept, so they are copied instead if T's
+//           move constructor may throw and T can be copied). If an
+//           exception is thrown while growing, the sequence is left
+//           unchanged.
 //   void remove_current()
 //     Pre:  is_item() returns true.
 //     Post: The current item has been removed from the sequence, and
 //           the item after this (if there is one) is now the new current
 //           item. If the current item was already the last item in the
 //           sequence, then there is no longer any current item.
+//     Note: If an exception is thrown while items are shifted (by add,
+//           emplace or remove_current, moving items of a T whose move
+//           assignment may throw), the sequence is left valid but its
+//           items are unspecified.
+//   void reserve(size_type new_capacity)
+//     Pre:  (none)
+//     Post: The capacity is at least new_capacity (the items have been
+//           moved to a larger array if needed, as for add).
+//   void swap(sequence& other) noexcept
+//     Pre:  (none)
+//     Post: The sequence and other have exchanged their items, current
+//           items, capacities and growth factors.
 //
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
@@ -68,14 +113,53 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   size_type capacity() const
+//     Pre:  (none)
+//     Post: The return value is the number of items the sequence can
+//           hold before add or emplace must grow it.
+//
+// ITERATORS for the sequence class:
+//   class const_iterator
+//     A random access iterator (std::random_access_iterator_tag) over
+//     the items, from the first to the last; *it is a const T&, and it
+//     supports all of the iterator arithmetic and comparisons (it + n,
+//     it - other, it[n], it < other, ...). Reading through iterators
+//     neither copies the sequence nor uses (or moves) its current item.
+//     Any add, emplace, remove_current or reserve invalidates them.
+//   const_iterator begin() const
+//     Pre:  (none)
+//     Post: An iterator to the first item is returned (end() if the
+//           sequence is empty).
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: The past-the-end iterator of the sequence is returned.
+//     Note: On a sequence that is not const, s.end() names the cursor
+//           function end() above (which hides this one), so the
+//           iterator range of such a sequence is reached through
+//           cbegin() and cend() or items().
+//   const_iterator cbegin() const
+//   const_iterator cend() const
+//     Same as begin() and end().
+//   item_range items() const
+//     Pre:  (none)
+//     Post: A range whose begin() and end() are begin() and end() of
+//           the sequence is returned, so that range-based for (and
+//           anything else that calls begin() and end()) works on any
+//           sequence: for (const T& x : s.items()) ...
+//           It is invalidated along with the iterators.
 // VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
-//    objects.
+//    objects; so may move assignment and the move constructor, which
+//    never copy or throw. A copy assignment that throws leaves the
+//    sequence unchanged.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 
-#include <cstdlib>  // provides size_t
+#include <cstdlib>      // provides size_t
+#include <cstddef>      // provides ptrdiff_t
+#include <iterator>     // provides random_access_iterator_tag
+#include <type_traits>  // provides true_type, false_type
 
 namespace CS3358_FA17_A04
 {
@@ -86,25 +170,113 @@ namespace CS3358_FA17_A04
         // TYPEDEFS and MEMBER CONSTANTS
         typedef T value_type;
         typedef size_t size_type;
-        static const size_type CAPACITY = 10;
-        // CONSTRUCTOR
-        sequence();
+        class const_iterator;
+        static const size_type DEFAULT_CAPACITY = 10;
+        static constexpr double DEFAULT_GROWTH = 2.0;
+        // CONSTRUCTORS and DESTRUCTOR
+        sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+                 double growth = DEFAULT_GROWTH);
+        sequence(const sequence& source);
+        sequence(sequence&& source) noexcept;
+        ~sequence();
         // MODIFICATION MEMBER FUNCTIONS
         void start();
         void end();
         void advance();
         void move_back();
         void add(const T& entry);
+        void add(T&& entry);
+        template <class... Args>
+        void emplace(Args&&... args);
         void remove_current();
+        void reserve(size_type new_capacity);
+        void swap(sequence& other) noexcept;
+        sequence& operator=(const sequence& source);
+        sequence& operator=(sequence&& source) noexcept;
         // CONSTANT MEMBER FUNCTIONS
         size_type size() const;
         bool is_item() const;
         T current() const;
+        size_type capacity() const;
+        // ITERATORS
+        class const_iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T* pointer;
+            typedef const T& reference;
+            const_iterator();
+            reference operator*() const;
+            pointer operator->() const;
+            reference operator[](difference_type n) const;
+            const_iterator& operator++();
+            const_iterator operator++(int);
+            const_iterator& operator--();
+            const_iterator operator--(int);
+            const_iterator& operator+=(difference_type n);
+            const_iterator& operator-=(difference_type n);
+            const_iterator operator+(difference_type n) const;
+            const_iterator operator-(difference_type n) const;
+            difference_type operator-(const const_iterator& rhs) const;
+            bool operator==(const const_iterator& rhs) const;
+            bool operator!=(const const_iterator& rhs) const;
+            bool operator<(const const_iterator& rhs) const;
+            bool operator>(const const_iterator& rhs) const;
+            bool operator<=(const const_iterator& rhs) const;
+            bool operator>=(const const_iterator& rhs) const;
+            // n + it (defined here, as T cannot be deduced for a
+            // function template outside the class)
+            friend const_iterator operator+(difference_type n,
+                                            const const_iterator& it)
+            { return it + n; }
+        private:
+            friend class sequence;
+            const sequence* seq;
+            size_type pos;
+            const_iterator(const sequence* owner, size_type start);
+        };
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        class item_range
+        {
+        public:
+            const_iterator begin() const;
+            const_iterator end() const;
+        private:
+            friend class sequence;
+            const sequence* seq;
+            explicit item_range(const sequence* owner);
+        };
+        item_range items() const;
         
     private:
-        T data[CAPACITY];
+        T* data;
         size_type used;
         size_type current_index;
+        size_type allocated;
+        size_type head;
+        double growth;
+        size_type slot(size_type index) const;
+        T& item(size_type index);
+        void shift(size_type to, size_type from, size_type count);
+        void relocate_out(T* dest, size_type index, size_type count);
+        void destroy_items(size_type index, size_type count);
+        static T* allocate(size_type n);
+        static void relocate(T* dest, T* source, size_type count);
+        static void relocate(T* dest, T* source, size_type count,
+                             std::true_type);
+        static void relocate(T* dest, T* source, size_type count,
+                             std::false_type);
+        static void destroy(T* items, size_type count);
+        static void move_items(T* dest, T* source, size_type count);
+        static void move_items(T* dest, T* source, size_type count,
+                               std::true_type);
+        static void move_items(T* dest, T* source, size_type count,
+                               std::false_type);
     };
 }
 #include "sequence.cpp"
@@ -0,0 +1,240 @@
+// FILE: sequenceBench.cpp
+// A non-interactive benchmark program for the sequence class on traces
+// that add and remove items at the ends of the sequence.
+//
+// USAGE: ./a4bench [n [ops]]
+//        where n is the # of items each trace keeps in the sequence
+//        (default 50000) and ops is the # of operations each trace
+//        makes (default 50000).
+//
+// TRACES (each starts from a sequence of n items 0, 1, 2, ...)
+//   front adds:    ops items are added at the front (with no current
+//                  item), as a stack kept at the head would be
+//   fifo:          each step adds an item at the front and removes the
+//                  last item, so the sequence stays at n items
+//   both ends:     a random mix of adds and removes at the front and at
+//                  the back
+// Each trace is also run on a std::vector<double> (which shifts every
+// item on an add or remove at the front) and on a std::deque<double>,
+// and the items left are checked against those of the sequence; the
+// average time per operation (in ns) is reported.
+
+#include <iostream>    // provides cout
+#include <iomanip>     // provides setw
+#include <cstdlib>     // provides atoi, EXIT_SUCCESS
+#include <ctime>       // provides clock
+#include <vector>      // provides vector
+#include <deque>       // provides deque
+#include <algorithm>   // provides equal
+#include "sequence.h"
+using namespace std;
+using namespace CS3358_FA17_A04;
+
+// PROTOTYPES for functions used by this benchmark program:
+
+// Each trace comes in two forms: one for sequence<double>, and one for
+// a standard container (vector or deque), using insert and erase at the
+// same places.
+void front_adds(sequence<double>& s, size_t ops);
+template <class Container>
+void front_adds(Container& c, size_t ops);
+void fifo(sequence<double>& s, size_t ops);
+template <class Container>
+void fifo(Container& c, size_t ops);
+void both_ends(sequence<double>& s, size_t ops);
+template <class Container>
+void both_ends(Container& c, size_t ops);
+// Pre:  (none)
+// Post: The trace (see TRACES above) has been run on s (or c).
+
+void fill(sequence<double>& s, size_t n);
+template <class Container>
+void fill(Container& c, size_t n);
+// Pre:  s (c) is empty.
+// Post: The items 0, 1, ..., n - 1 have been added to the back of s (c).
+
+template <class Seq>
+double time_trace(void (*trace)(Seq&, size_t), Seq& s, size_t n,
+                  size_t ops);
+// Pre:  s is empty.
+// Post: s has been filled with n items and trace run on it; the CPU
+//       time (in seconds) the trace took is returned.
+
+void report(const char name[], double secs, size_t ops, bool same);
+// Pre:  (none)
+// Post: A line giving the time per operation has been written to cout
+//       (and a note if the items left differ from the sequence's).
+
+unsigned next_random(unsigned& seed);
+// Pre:  (none)
+// Post: seed has been advanced and the next pseudo-random number
+//       returned.
+
+int main(int argc, char* argv[])
+{
+    size_t n = 50000, ops = 50000;
+    if (argc > 1)
+        n = size_t(atoi(argv[1]));
+    if (argc > 2)
+        ops = size_t(atoi(argv[2]));
+
+    const int TRACES = 3;
+    const char* NAMES[TRACES] = { "front adds", "fifo", "both ends" };
+    void (*on_sequence[TRACES])(sequence<double>&, size_t) =
+        { front_adds, fifo, both_ends };
+    void (*on_vector[TRACES])(vector<double>&, size_t) =
+        { front_adds<vector<double> >, fifo<vector<double> >,
+          both_ends<vector<double> > };
+    void (*on_deque[TRACES])(deque<double>&, size_t) =
+        { front_adds<deque<double> >, fifo<deque<double> >,
+          both_ends<deque<double> > };
+
+    for (int t = 0; t < TRACES; ++t)
+    {
+        cout << NAMES[t] << " (" << n << " items, " << ops << " ops):"
+             << endl;
+        sequence<double> s;
+        vector<double> v;
+        deque<double> d;
+        double secs = time_trace(on_sequence[t], s, n, ops);
+        report("sequence<double>", secs, ops, true);
+        secs = time_trace(on_vector[t], v, n, ops);
+        report("vector<double>", secs, ops,
+               v.size() == s.size() && equal(v.begin(), v.end(), s.begin()));
+        secs = time_trace(on_deque[t], d, n, ops);
+        report("deque<double>", secs, ops,
+               d.size() == s.size() && equal(d.begin(), d.end(), s.begin()));
+    }
+    return EXIT_SUCCESS;
+}
+
+void front_adds(sequence<double>& s, size_t ops)
+{
+    s.start();
+    for (size_t i = 0; i < ops; ++i)
+    {
+        if (s.is_item())
+            s.move_back();
+        s.add(-double(i));
+    }
+}
+
+template <class Container>
+void front_adds(Container& c, size_t ops)
+{
+    for (size_t i = 0; i < ops; ++i)
+        c.insert(c.begin(), -double(i));
+}
+
+void fifo(sequence<double>& s, size_t ops)
+{
+    for (size_t i = 0; i < ops; ++i)
+    {
+        s.start();
+        if (s.is_item())
+            s.move_back();
+        s.add(-double(i));
+        s.end();
+        s.remove_current();
+    }
+}
+
+template <class Container>
+void fifo(Container& c, size_t ops)
+{
+    for (size_t i = 0; i < ops; ++i)
+    {
+        c.insert(c.begin(), -double(i));
+        c.erase(c.end() - 1);
+    }
+}
+
+void both_ends(sequence<double>& s, size_t ops)
+{
+    unsigned seed = 2017u;
+    for (size_t i = 0; i < ops; ++i)
+    {
+        unsigned r = next_random(seed) % 4;
+        if (r == 0 || s.size() == 0)
+        {
+            s.start();
+            if (s.is_item())
+                s.move_back();
+            s.add(-double(i));
+        }
+        else if (r == 1)
+        {
+            s.end();
+            s.add(-double(i));
+        }
+        else if (r == 2)
+        {
+            s.start();
+            s.remove_current();
+        }
+        else
+        {
+            s.end();
+            s.remove_current();
+        }
+    }
+}
+
+template <class Container>
+void both_ends(Container& c, size_t ops)
+{
+    unsigned seed = 2017u;
+    for (size_t i = 0; i < ops; ++i)
+    {
+        unsigned r = next_random(seed) % 4;
+        if (r == 0 || c.size() == 0)
+            c.insert(c.begin(), -double(i));
+        else if (r == 1)
+            c.insert(c.end(), -double(i));
+        else if (r == 2)
+            c.erase(c.begin());
+        else
+            c.erase(c.end() - 1);
+    }
+}
+
+void fill(sequence<double>& s, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        s.end();
+        s.add(double(i));
+    }
+}
+
+template <class Container>
+void fill(Container& c, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        c.insert(c.end(), double(i));
+}
+
+template <class Seq>
+double time_trace(void (*trace)(Seq&, size_t), Seq& s, size_t n,
+                  size_t ops)
+{
+    fill(s, n);
+    clock_t start = clock();
+    trace(s, ops);
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void report(const char name[], double secs, size_t ops, bool same)
+{
+    cout << "   " << left << setw(18) << name << right << fixed
+         << setprecision(1) << setw(12) << secs * 1e9 / ops << " ns/op";
+    if (!same)
+        cout << "   *** items differ";
+    cout << endl;
+}
+
+unsigned next_random(unsigned& seed)
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
@@ -4,6 +4,7 @@
 #include <cctype>      // provides toupper
 #include <iostream>    // provides cout and cin
 #include <cstdlib>     // provides EXIT_SUCCESS
+#include <algorithm>   // provides find
 #include "sequence.h"
 using namespace std;
 using namespace CS3358_FA17_A04;
@@ -19,9 +20,18 @@ char get_user_command();
 //       The next character is read (skipping blanks and newline
 //       characters), and this character is returned.
 template <class T>
-void show_list(sequence<T> src);
+void show_list(const sequence<T>& src);
 // Pre: (none)
 // Post: The items of src are printed to cout (one per line).
+template <class T>
+void find_item(sequence<T>& src, const T& target, const char name[]);
+// Pre: (none)
+// Post: The position (counting from 0) of the first item of src equal
+//       to target, found with std::find over cbegin() and cend(), and
+//       the # of items equal to it, counted with a range-based for over
+//       items(), are printed to cout (or a note that there are none).
+//       src is taken by non-const reference, where end() is the cursor
+//       function.
 int get_object_num();
 // Pre:  (none)
 // Post: The user is prompted to enter either 1 or 2. The
@@ -245,6 +255,19 @@ int main(int argc, char *argv[])
                         cout << "s2 has no current item." << endl;
                 }
                 break;
+            case 'F':
+                objectNum = get_object_num();
+                if (objectNum == 1)
+                {
+                    numHold = get_number();
+                    find_item(s1, numHold, "s1");
+                }
+                else
+                {
+                    charHold = get_character();
+                    find_item(s2, charHold, "s2");
+                }
+                break;
             case 'Q':
                 cout << "Quit option selected...bye" << endl;
                 break;
@@ -274,6 +297,7 @@ void print_menu()
     cout << "  S  Print the result from the size() function\n";
     cout << "  A  Add a new item with the add(...) function\n";
     cout << "  R  Activate the remove_current() function\n";
+    cout << "  F  Find an item with std::find\n";
     cout << "  Q  Quit this test program" << endl;
 }
 
@@ -290,10 +314,28 @@ char get_user_command()
 }
 
 template <class T>
-void show_list(sequence<T> src)
+void show_list(const sequence<T>& src)
+{
+    typename sequence<T>::const_iterator it;
+    for (it = src.begin(); it != src.end(); ++it)
+        cout << *it << "  ";
+}
+
+template <class T>
+void find_item(sequence<T>& src, const T& target, const char name[])
 {
-    for ( src.start(); src.is_item(); src.advance() )
-        cout << src.current() << "  ";
+    size_t count = 0;
+    for (const T& item : src.items())
+        if (item == target)
+            ++count;
+
+    typename sequence<T>::const_iterator it =
+        find(src.cbegin(), src.cend(), target);
+    if (it == src.cend())
+        cout << target << " is not in " << name << "." << endl;
+    else
+        cout << target << " first found at position " << it - src.cbegin()
+             << " of " << name << " (" << count << " in all)." << endl;
 }
 
 int get_object_num()
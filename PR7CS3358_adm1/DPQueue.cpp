@@ -17,6 +17,13 @@
 //          NOTE: The size of the dynamic array (thus capacity) can
 //                be resized up or down where needed or appropriate
 //                by calling resize(...).
+//      2.3 The dynamic array is got from a memory_resource (see
+//          MemoryResource.h) by allocate_heap(...), which keeps a
+//          pointer to the memory_resource in a header of HEAP_HEADER
+//          bytes just in front of heap[0]; that is the p_queue's
+//          memory_resource (there is no member variable for it, so
+//          that a p_queue is the same size as it always was), and the
+//          array goes back to it through free_heap(...).
 // NOTE: Private helper functions are implemented at the bottom of
 // this file along with their precondition/postcondition contracts.
 
@@ -31,6 +38,13 @@ using namespace std;
 
 namespace CS3358_FA17A7
 {
+    namespace
+    {
+        // size of the header in front of the dynamic array (see 2.3),
+        // kept at MAX_ALIGN so the items after it stay aligned
+        const size_t HEAP_HEADER = memory_resource::MAX_ALIGN;
+    }
+
     // EXTRA MEMBER FUNCTIONS FOR DEBUG PRINTING
     void p_queue::print_tree(const char message[], size_type i) const
     // Pre:  (none)
@@ -109,23 +123,44 @@ namespace CS3358_FA17A7
             capacity = DEFAULT_CAPACITY;
         
         // allocate the new array
-        heap = new ItemType [capacity];
+        heap = allocate_heap(capacity, new_delete_resource());
+    }
+    
+    // CONSTRUCTOR WITH A MEMORY RESOURCE
+    p_queue::p_queue(size_type initial_capacity, memory_resource* resource) : capacity(initial_capacity), used(0)
+    {
+        // pre condition
+        if (capacity < 1)
+            capacity = DEFAULT_CAPACITY;
+        
+        // allocate the new array from resource
+        heap = allocate_heap(capacity, resource);
     }
     
     // COPY CONSTRUCTOR DONE
     p_queue::p_queue(const p_queue& src) : capacity(src.capacity), used(src.used)
     {
-        // declare the new int array
-        heap = new ItemType [src.capacity];
+        // declare the new array
+        heap = allocate_heap(src.capacity, new_delete_resource());
         
         // set the data of the array
-        memcpy(heap, src.heap, sizeof(src.heap) * used);
+        memcpy(heap, src.heap, sizeof(ItemType) * used);
+    }
+    
+    // COPY CONSTRUCTOR WITH A MEMORY RESOURCE
+    p_queue::p_queue(const p_queue& src, memory_resource* resource) : capacity(src.capacity), used(src.used)
+    {
+        // declare the new array, from resource
+        heap = allocate_heap(src.capacity, resource);
+        
+        // set the data of the array
+        memcpy(heap, src.heap, sizeof(ItemType) * used);
     }
     
     // DESTRUCTOR DONE
     p_queue::~p_queue()
     {
-        delete [] heap;
+        free_heap(heap, capacity);
     }
     
     // MODIFICATION MEMBER FUNCTIONS
@@ -134,18 +169,18 @@ namespace CS3358_FA17A7
     {
         if(&rhs != this)
         {
-            // set used and capacity to the rhs capacity.
-            used = rhs.used;
-            capacity = rhs.capacity;
-            
-            // declare a new data array.
-            ItemType *newHeap = new ItemType [rhs.capacity];
+            // declare a new data array (from our own memory_resource).
+            ItemType *newHeap = allocate_heap(rhs.capacity, resource_of(heap));
             
             // copy values from rhs to new array
-            memcpy(newHeap, rhs.heap, sizeof(rhs.heap) * used);
+            memcpy(newHeap, rhs.heap, sizeof(ItemType) * rhs.used);
             
-            // delete the existing array
-            delete heap;
+            // delete the existing array (while capacity is still its size)
+            free_heap(heap, capacity);
+            
+            // set used and capacity to the rhs capacity.
+            used = rhs.used;
+            capacity = rhs.capacity;
             
             // assign the pointer to the new Array
             heap = newHeap;
@@ -235,6 +270,11 @@ namespace CS3358_FA17A7
         //}
     }
     
+    memory_resource* p_queue::get_resource() const
+    {
+        return resource_of(heap);
+    }
+    
     p_queue::size_type p_queue::size() const
     {
         return used;
@@ -263,6 +303,35 @@ namespace CS3358_FA17A7
     }
     
     // PRIVATE HELPER FUNCTIONS
+    p_queue::ItemType* p_queue::allocate_heap(size_type n, memory_resource* resource)
+    // Pre:  n > 0
+    // Post: A dynamic array of n items, got from resource, has been
+    //       returned, with resource recorded in the header in front of
+    //       it (see 2.3 of the INVARIANT).
+    {
+        char* block = static_cast<char*>(resource->allocate(HEAP_HEADER + n * sizeof(ItemType)));
+        *reinterpret_cast<memory_resource**>(block) = resource;
+        return reinterpret_cast<ItemType*>(block + HEAP_HEADER);
+    }
+    
+    void p_queue::free_heap(ItemType* items, size_type n)
+    // Pre:  items was returned by allocate_heap(n, ...) and has not
+    //       been freed since.
+    // Post: The array has been given back to its memory_resource.
+    {
+        char* block = reinterpret_cast<char*>(items) - HEAP_HEADER;
+        resource_of(items)->deallocate(block, HEAP_HEADER + n * sizeof(ItemType));
+    }
+    
+    memory_resource* p_queue::resource_of(const ItemType* items)
+    // Pre:  items was returned by allocate_heap(...).
+    // Post: The memory_resource the array was got from has been
+    //       returned.
+    {
+        const char* block = reinterpret_cast<const char*>(items) - HEAP_HEADER;
+        return *reinterpret_cast<memory_resource* const*>(block);
+    }
+    
     // RESIZE DONE!
     void p_queue::resize(size_type new_capacity)
     {
@@ -278,15 +347,15 @@ namespace CS3358_FA17A7
         if(new_capacity < 1)
             new_capacity = 1;
         
-        capacity = new_capacity;
-        
-        ItemType *temp = new ItemType [capacity];
+        ItemType *temp = allocate_heap(new_capacity, resource_of(heap));
         
         for(size_type i = 0; i < used; i++)
             temp[i] = heap[i];
         
-        delete [] heap;
+        // free the old array before capacity stops being its size
+        free_heap(heap, capacity);
         
+        capacity = new_capacity;
         heap = temp;
     }
     
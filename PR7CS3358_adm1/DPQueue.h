@@ -37,6 +37,17 @@
 //       is to ensure no attempt is made at allocating memory that's
 //       0 in amount).
 //
+//   p_queue(size_type initial_capacity, memory_resource* resource)
+//     Pre:  resource (see MemoryResource.h) outlasts the p_queue.
+//     Post: Same as above, except that all of the p_queue's memory is
+//       got from resource (the constructor above, and the copy
+//       constructor, use new_delete_resource()).
+//
+//   p_queue(const p_queue& src, memory_resource* resource)
+//     Pre:  resource outlasts the p_queue.
+//     Post: The p_queue is a copy of src, with its memory from
+//       resource.
+//
 // MODIFICATION MEMBER FUNCTIONS for the p_queue class:
 //   void push(const value_type& entry, size_type priority)
 //     Pre:  (none)
@@ -50,6 +61,11 @@
 //           then the implementation may decide which one to remove.)
 //
 // CONSTANT MEMBER FUNCTIONS for the p_queue class:
+//   memory_resource* get_resource() const
+//     Pre:  (none)
+//     Post: The return value is the memory_resource the p_queue gets
+//           its memory from.
+//
 //   size_type size() const
 //     Pre:  (none)
 //     Post: The return value is the total number of items in the
@@ -69,12 +85,13 @@
 //
 // VALUE SEMANTICS for the p_queue class:
 //   Assignments and the copy constructor may be used with p_queue
-//   objects.
+//   objects. A p_queue assigned to keeps its own memory_resource.
 
 #ifndef D_P_QUEUE_H
 #define D_P_QUEUE_H
 
 #include <cstdlib> // provides size_t
+#include "MemoryResource.h"
 
 namespace CS3358_FA17A7
 {
@@ -87,13 +104,16 @@ namespace CS3358_FA17A7
       static const size_type DEFAULT_CAPACITY = 1;
       // CONSTRUCTORS AND DESTRUCTOR
       p_queue(size_type initial_capacity = DEFAULT_CAPACITY);
+      p_queue(size_type initial_capacity, memory_resource* resource);
       p_queue(const p_queue& src);
+      p_queue(const p_queue& src, memory_resource* resource);
       ~p_queue();
       // MODIFICATION MEMBER FUNCTIONS
       p_queue& operator=(const p_queue& rhs);
       void push(const value_type& entry, size_type priority);
       void pop();
       // CONSTANT MEMBER FUNCTIONS
+      memory_resource* get_resource() const;
       size_type size() const;
       bool empty() const;
       value_type front() const;
@@ -113,6 +133,9 @@ namespace CS3358_FA17A7
       size_type capacity;
       size_type used;
       // HELPER FUNCTIONS
+      static ItemType* allocate_heap(size_type n, memory_resource* resource);
+      static void free_heap(ItemType* items, size_type n);
+      static memory_resource* resource_of(const ItemType* items);
       void resize(size_type new_capacity);
       bool is_leaf(size_type i) const;
       size_type parent_index(size_type i) const;
@@ -0,0 +1,157 @@
+// FILE: MemoryResource.cpp
+// CLASSES IMPLEMENTED: memory_resource, monotonic_arena (see
+//                      MemoryResource.h for documentation)
+// INVARIANT for the monotonic_arena class:
+//   1. The blocks got from upstream form a list linked through their
+//      headers (a block struct at the start of each, padded to a
+//      multiple of MAX_ALIGN bytes); chain points to the newest (null
+//      if there are none), and each header holds the size the block
+//      was allocated with. There are block_count of them.
+//   2. The bytes not yet handed out are the bytes_left bytes starting
+//      at next_free: the rest of the newest block, or of
+//      initial_buffer before any block has been got (next_free is null
+//      if there are no such bytes at all).
+//   3. next_block_size is the size of the next block to get from
+//      upstream (doubling each time), and initial_buffer,
+//      initial_size and first_block_size are what the arena was
+//      constructed with, for release to go back to.
+
+#include <cassert>
+#include <new>      // provides operator new, bad_alloc
+#include "MemoryResource.h"
+using namespace std;
+
+namespace
+{
+   // Pre:  alignment is a power of 2.
+   // Post: The # of bytes to skip from p to an address that is a
+   //       multiple of alignment is returned.
+   size_t padding(const char* p, size_t alignment)
+   {
+      return (alignment - reinterpret_cast<size_t>(p) % alignment)
+             % alignment;
+   }
+
+   class new_delete_memory_resource : public memory_resource
+   {
+   private:
+      virtual void* do_allocate(size_t bytes, size_t)
+      {
+         // operator new's memory is aligned for any built-in type
+         return ::operator new(bytes);
+      }
+
+      virtual void do_deallocate(void* p, size_t, size_t)
+      {
+         ::operator delete(p);
+      }
+   };
+}
+
+// memory_resource
+memory_resource::memory_resource() { }
+
+memory_resource::~memory_resource() { }
+
+void* memory_resource::allocate(size_t bytes, size_t alignment)
+{
+    assert(alignment > 0 && alignment <= MAX_ALIGN
+           && (alignment & (alignment - 1)) == 0);
+    return do_allocate(bytes, alignment);
+}
+
+void memory_resource::deallocate(void* p, size_t bytes, size_t alignment)
+{
+    do_deallocate(p, bytes, alignment);
+}
+
+bool memory_resource::is_equal(const memory_resource& other) const
+{
+    return do_is_equal(other);
+}
+
+bool memory_resource::do_is_equal(const memory_resource& other) const
+{
+    return this == &other;
+}
+
+memory_resource* new_delete_resource()
+{
+    static new_delete_memory_resource resource;
+    return &resource;
+}
+
+// monotonic_arena
+monotonic_arena::monotonic_arena(size_t block_size,
+                                 memory_resource* upstream)
+   : upstream(upstream), chain(0), block_count(0), next_free(0),
+     bytes_left(0), next_block_size(block_size), initial_buffer(0),
+     initial_size(0), first_block_size(block_size)
+{
+    assert(block_size > 0 && upstream != 0);
+}
+
+monotonic_arena::monotonic_arena(void* buffer, size_t size,
+                                 memory_resource* upstream)
+   : upstream(upstream), chain(0), block_count(0),
+     next_free(static_cast<char*>(buffer)), bytes_left(size),
+     next_block_size(size > 0 ? size : DEFAULT_BLOCK_SIZE),
+     initial_buffer(static_cast<char*>(buffer)), initial_size(size),
+     first_block_size(size > 0 ? size : DEFAULT_BLOCK_SIZE)
+{
+    assert(upstream != 0);
+}
+
+monotonic_arena::~monotonic_arena()
+{
+    release();
+}
+
+void monotonic_arena::release()
+{
+    while (chain != 0)
+    {
+        block* next = chain->next;
+        upstream->deallocate(chain, chain->bytes);
+        chain = next;
+    }
+    block_count = 0;
+    next_free = initial_buffer;
+    bytes_left = initial_size;
+    next_block_size = first_block_size;
+}
+
+size_t monotonic_arena::blocks() const
+{
+    return block_count;
+}
+
+void* monotonic_arena::do_allocate(size_t bytes, size_t alignment)
+{
+    const size_t HEADER_BYTES =
+       (sizeof(block) + MAX_ALIGN - 1) / MAX_ALIGN * MAX_ALIGN;
+    size_t skip = padding(next_free, alignment);
+    if (next_free == 0 || skip + bytes > bytes_left)
+    {
+        size_t size = next_block_size;
+        if (size < HEADER_BYTES + bytes)
+        {
+            size = HEADER_BYTES + bytes;
+        }
+        block* added = static_cast<block*>(upstream->allocate(size));
+        added->next = chain;
+        added->bytes = size;
+        chain = added;
+        block_count = block_count + 1;
+        next_free = reinterpret_cast<char*>(added) + HEADER_BYTES;
+        bytes_left = size - HEADER_BYTES;
+        next_block_size = 2 * next_block_size;
+        skip = 0;   // next_free is aligned to MAX_ALIGN
+    }
+    char* result = next_free + skip;
+    next_free = result + bytes;
+    bytes_left = bytes_left - skip - bytes;
+    return result;
+}
+
+void monotonic_arena::do_deallocate(void*, size_t, size_t) { }
@@ -0,0 +1,151 @@
+// FILE: MemoryResource.h
+// CLASSES PROVIDED: memory_resource, monotonic_arena
+//
+// A memory_resource is where a container gets its memory from: a
+// container that takes one (sequence in CS3358_Assignment03, IntSet in
+// PR2_DS, p_queue in PR7CS3358_adm1) calls its allocate and deallocate
+// instead of new and delete. The interface is the part of C++17's
+// std::pmr::memory_resource these containers need, written so that it
+// builds as C++98 (the assignments) and as C++11 (PR2_DS). Each of
+// them gets this one copy through -I../common in its Makefile.
+// new_delete_resource() is the one containers use unless they are given
+// another; a monotonic_arena hands out memory from a few large blocks
+// and frees all of it at once.
+//
+// MEMBER CONSTANT for the memory_resource class:
+//   static const std::size_t MAX_ALIGN = 16
+//    memory_resource::MAX_ALIGN is the largest alignment allocate
+//    supports (and the default), enough for any of the built-in types.
+//
+// MEMBER FUNCTIONS for the memory_resource class:
+//   void* allocate(std::size_t bytes, std::size_t alignment = MAX_ALIGN)
+//    Pre:  alignment is a power of 2 no larger than MAX_ALIGN.
+//    Post: A pointer to bytes bytes of memory (never null), aligned to
+//      alignment, is returned; std::bad_alloc is thrown if there is no
+//      memory for it.
+//
+//   void deallocate(void* p, std::size_t bytes,
+//                   std::size_t alignment = MAX_ALIGN)
+//    Pre:  p was returned by allocate(bytes, alignment) of this
+//      memory_resource and has not been deallocated since.
+//    Post: The memory at p has been given back to the memory_resource.
+//
+//   bool is_equal(const memory_resource& other) const
+//    Pre:  none
+//    Post: True is returned if memory allocated from either of the two
+//      memory_resources can be deallocated by the other (for the classes
+//      here: if they are the same object).
+//
+// DERIVED CLASSES of the memory_resource class:
+//   A class derived from memory_resource defines the private virtual
+//   functions do_allocate(bytes, alignment) and
+//   do_deallocate(p, bytes, alignment), which allocate and deallocate
+//   call (with the same Pre and Post); it may also redefine
+//   do_is_equal(other), which is_equal calls.
+//
+// NONMEMBER FUNCTION for the memory_resource class:
+//   memory_resource* new_delete_resource()
+//    Pre:  none
+//    Post: A memory_resource that gets each allocation from operator
+//      new and gives it back with operator delete is returned (the same
+//      one every time; it lasts as long as the program).
+//
+// CONSTRUCTORS for the monotonic_arena class:
+//   explicit monotonic_arena(std::size_t block_size = DEFAULT_BLOCK_SIZE,
+//                   memory_resource* upstream = new_delete_resource())
+//    Pre:  block_size > 0 and upstream is not null.
+//    Post: The monotonic_arena has been initialized with no memory; the
+//      first time it needs some it gets a block of block_size bytes from
+//      upstream, and each block after that is twice the size of the one
+//      before (or as large as the allocation it is needed for).
+//
+//   monotonic_arena(void* buffer, std::size_t size,
+//                   memory_resource* upstream = new_delete_resource())
+//    Pre:  buffer points to size bytes that are not otherwise used while
+//      the monotonic_arena is, and upstream is not null.
+//    Post: As above, except that the bytes of buffer are handed out
+//      first (so a buffer on the stack can serve a container without any
+//      allocation at all).
+//
+// MEMBER FUNCTIONS for the monotonic_arena class:
+//   allocate, deallocate and is_equal
+//    As for memory_resource: allocate takes the next (suitably aligned)
+//    bytes of the current block, and deallocate does nothing (the
+//    memory is only given back, all of it at once, by release).
+//
+//   void release()
+//    Pre:  none
+//    Post: Every block got from upstream has been given back to it, and
+//      the monotonic_arena is as it was when it was constructed (so
+//      none of the memory it handed out may be used any more).
+//
+//   std::size_t blocks() const
+//    Pre:  none
+//    Post: The number of blocks the monotonic_arena holds from upstream
+//      is returned.
+//
+//   ~monotonic_arena()
+//    Calls release().
+//
+// VALUE SEMANTICS for the memory_resource and monotonic_arena classes:
+//   Neither can be copied or assigned: containers hold pointers to
+//   them, so a memory_resource must outlast every container using it.
+
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+#include <cstdlib>  // provides size_t
+
+class memory_resource
+{
+public:
+   static const std::size_t MAX_ALIGN = 16;
+   memory_resource();
+   virtual ~memory_resource();
+   void* allocate(std::size_t bytes, std::size_t alignment = MAX_ALIGN);
+   void deallocate(void* p, std::size_t bytes,
+                   std::size_t alignment = MAX_ALIGN);
+   bool is_equal(const memory_resource& other) const;
+private:
+   virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+   virtual void do_deallocate(void* p, std::size_t bytes,
+                              std::size_t alignment) = 0;
+   virtual bool do_is_equal(const memory_resource& other) const;
+   memory_resource(const memory_resource&);
+   memory_resource& operator=(const memory_resource&);
+};
+
+memory_resource* new_delete_resource();
+
+class monotonic_arena : public memory_resource
+{
+public:
+   static const std::size_t DEFAULT_BLOCK_SIZE = 4096;
+   explicit monotonic_arena(std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                            memory_resource* upstream =
+                               new_delete_resource());
+   monotonic_arena(void* buffer, std::size_t size,
+                   memory_resource* upstream = new_delete_resource());
+   ~monotonic_arena();
+   void release();
+   std::size_t blocks() const;
+private:
+   struct block
+   {
+      block* next;
+      std::size_t bytes;
+   };
+   memory_resource* upstream;
+   block* chain;
+   std::size_t block_count;
+   char* next_free;
+   std::size_t bytes_left;
+   std::size_t next_block_size;
+   char* initial_buffer;
+   std::size_t initial_size;
+   std::size_t first_block_size;
+   virtual void* do_allocate(std::size_t bytes, std::size_t alignment);
+   virtual void do_deallocate(void* p, std::size_t bytes,
+                              std::size_t alignment);
+};
+
+#endif